@@ -11,8 +11,8 @@ int main() {
         IoTData iotData(initialData);
 
         // Append new data
-        iotData.appendData(14.3);
-        iotData.appendData(8.7);
+        iotData.appendData(14.3, 5.0);
+        iotData.appendData(8.7, 6.0);
 
         // Display the data
         std::cout << "Original Data: ";
@@ -2,8 +2,72 @@
 #ifndef IOT_DATA_H
 #define IOT_DATA_H
 
+#include <cstdint>
 #include <vector>
+#include <string>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include "IoTDataView.h"
+
+class IoTDataSelection;
+class IoTDataAggregate;
+class IoTDataCalibration;
+struct IoTDataPlotOptions;
+
+// Resolution of points that share a timestamp (e.g. collector retries)
+enum class DuplicatePolicy {
+    KEEP_ALL,
+    KEEP_FIRST,
+    KEEP_LAST,
+    AVERAGE,
+    MAX
+};
+
+// Handling of binary blocks whose checksum or header is invalid
+enum class CorruptionPolicy {
+    SKIP,   // Import every intact block and report the corrupted byte ranges
+    FAIL    // Throw IoTDataFileException listing the corrupted byte ranges
+};
+
+// Options applied by importDataFromFile after the file has been read
+struct IoTDataImportOptions {
+    bool sortByTimestamp = false;   // Co-sort timestamps and data (for unsorted dumps; implied by duplicates)
+    DuplicatePolicy duplicates = DuplicatePolicy::KEEP_ALL;
+    size_t threadCount = 0;         // Parallel parsing of gzip files written by this library (0 = all cores)
+    CorruptionPolicy corruption = CorruptionPolicy::SKIP;
+};
+
+// Bytes of a binary file left out of an import. pointIndex is where the lost points would have been in the
+// imported series, before any sorting or duplicate resolution.
+struct IoTDataCorruptedRange {
+    uint64_t byteOffset;
+    uint64_t byteLength;
+    size_t pointIndex;
+};
+
+struct IoTDataImportReport {
+    size_t importedPoints = 0;
+    std::vector<IoTDataCorruptedRange> corruptedRanges;
+};
+
+enum class ExportFormat {
+    CSV,
+    BINARY
+};
+
+// Compression of exported files; imports recognise gzip input by its magic bytes
+enum class CompressionFormat {
+    NONE,
+    GZIP
+};
+
+struct IoTDataExportOptions {
+    ExportFormat format = ExportFormat::CSV;
+    CompressionFormat compression = CompressionFormat::NONE;
+    int compressionLevel = 6;       // zlib level, 1 (fastest) to 9 (smallest)
+    size_t threadCount = 0;         // Parallel compression of gzip members (0 = all cores)
+};
 
 enum class InterpolationMethod {
     LINEAR,
@@ -11,11 +75,109 @@ enum class InterpolationMethod {
     CUBIC_SPLINE
 };
 
+// Spread used by normalizeData: standard deviation, range, or interquartile range around the median
+enum class NormalizationMethod {
+    Z_SCORE,
+    MIN_MAX,
+    ROBUST
+};
+
+// Summation used by the mean and standard deviation kernels: plain SIMD accumulation, or
+// Kahan-Babuska compensated accumulation (accurate for long series with large offsets, e.g. epoch timestamps)
+enum class SummationMethod {
+    FAST,
+    COMPENSATED
+};
+
+// Bounds of the non-NaN values of one block of IoTData::kSummaryBlockSize points. Bounds always contain
+// every value of the block but may be wider than the exact extremes after in-place edits.
+struct IoTDataBlockSummary {
+    double minimum;
+    double maximum;
+    bool hasNan;
+};
+
 class IoTData {
+public:
+    // Callback invoked for every point accepted by appendData
+    using AppendListener = std::function<void(double value, double timestamp)>;
+
+    // Points per block summary (a multiple of 64, so blocks map onto whole selection words)
+    static constexpr size_t kSummaryBlockSize = 1024;
+
 private:
     std::vector<double> data;
     std::vector<double> timestamps;  // New member to store timestamps
 
+    // Ingest listeners (e.g. rule engines) keyed by the id returned from addAppendListener. They belong to
+    // the object they were added to: a copy starts without listeners and copy assignment keeps the target's.
+    // Listeners may add or remove listeners from their callback; such changes are applied once the
+    // outermost notify returns, so entries never move while one of them runs.
+    struct AppendListeners {
+        static constexpr size_t kRemovedListener = SIZE_MAX;       // Id of an entry removed while notifying
+
+        std::vector<std::pair<size_t, AppendListener>> entries;
+        std::vector<std::pair<size_t, AppendListener>> added;     // Added while notifying
+        size_t nextId = 0;
+        size_t notifyDepth = 0;
+        bool removedWhileNotifying = false;
+
+        AppendListeners() = default;
+        AppendListeners(const AppendListeners& other);
+        AppendListeners(AppendListeners&& other) = default;
+        AppendListeners& operator=(const AppendListeners& other);
+        AppendListeners& operator=(AppendListeners&& other) = default;
+
+        size_t add(AppendListener listener);
+        void remove(size_t listenerId);
+        void notify(double value, double timestamp);
+    };
+    AppendListeners appendListeners;
+
+    // Duplicate handling on append; only the most recent points are checked
+    static constexpr size_t kRecentDuplicateWindow = 8;
+    DuplicatePolicy duplicatePolicy = DuplicatePolicy::KEEP_ALL;
+    std::vector<std::pair<size_t, size_t>> recentDuplicateCounts;  // (index, merged points) for AVERAGE
+
+    // Applied to every appended value before it is stored (null when readings are stored as-is)
+    std::shared_ptr<const IoTDataCalibration> calibration;
+
+    // Cubic spline coefficients cached by the const interpolateData. Concurrent readers may race to fill
+    // it, so filling is guarded by the mutex; every mutator clears valid. Once valid, the coefficients are
+    // only read until the next mutation.
+    struct SplineCache {
+        mutable std::mutex mutex;
+        bool valid = false;
+        std::vector<double> coefficients;
+
+        SplineCache() = default;
+        SplineCache(const SplineCache& other);
+        SplineCache& operator=(const SplineCache& other);
+
+        void invalidate();
+        std::vector<double> copy() const;   // Coefficients when valid, otherwise empty
+    };
+    mutable SplineCache splineCache;
+
+    // Per-block value bounds, kept current by every mutation so scans can skip whole blocks
+    std::vector<IoTDataBlockSummary> blockSummaries;
+
+    bool mergeRecentDuplicate(double newData, double timestamp);
+
+    // Mean and variance of the values with the lowest and highest cut removed (or clamped when winsorizing)
+    void calculateCutMoments(double trimPercentage, bool winsorize, size_t threadCount, double& mean,
+                             double& variance) const;
+    void invalidateIndexes();
+    void summarizeBlocks(size_t fromIndex);
+    void includeInBlockSummary(size_t index);
+
+    // Snapshots persist the columns together with the cached state above
+    friend class IoTDataSnapshot;
+    friend class IoTDataSnapshotReader;
+
+    // Arrow export moves the columns out without copying
+    friend class IoTDataArrow;
+
     // Helper function for cubic spline interpolation
     std::vector<double> calculateSplineCoefficients(const std::vector<double>& x, const std::vector<double>& y) const;
 
@@ -26,26 +188,77 @@ public:
 
     // Basic data manipulation functions
     void appendData(double newData, double timestamp);
+    void appendData(const double* newData, const double* newTimestamps, size_t count);
     void clearData();
     size_t getDataSize() const;
 
-    // Data filtering functions
+    // Duplicate timestamp handling. The policy set here applies on append and only merges a point into one
+    // of the 8 most recent points; resolveDuplicateTimestamps sorts by timestamp first and merges every run.
+    void setDuplicatePolicy(DuplicatePolicy policy);
+    DuplicatePolicy getDuplicatePolicy() const;
+    void resolveDuplicateTimestamps(DuplicatePolicy policy);
+
+    // Ingest calibration: raw readings appended from now on are stored calibrated
+    void setCalibration(const IoTDataCalibration& calibration);
+    void clearCalibration();
+
+    // Ingest hooks
+    size_t addAppendListener(AppendListener listener);
+    void removeAppendListener(size_t listenerId);
+
+    // Zero-copy column access
+    IoTDataView view() const;
+    const std::vector<IoTDataBlockSummary>& getBlockSummaries() const;
+
+    // Data filtering functions: drops points with |value| > threshold. Blocks whose summary lies entirely
+    // inside or outside the threshold are kept or dropped wholesale; only straddling blocks are scanned.
     void filterOutliers(double threshold);
 
-    // Statistical analysis functions
+    // Statistical analysis functions (finalizers over calculateAggregate)
     double calculateMean() const;
     double calculateStandardDeviation() const;
+    double calculateMean(SummationMethod method) const;
+    double calculateStandardDeviation(SummationMethod method) const;
+
+    // Mergeable partial aggregate of the values (see IoTDataAggregate.h); threadCount 0 uses all cores
+    IoTDataAggregate calculateAggregate(size_t threadCount = 0) const;
+    IoTDataAggregate calculateAggregate(SummationMethod method, size_t threadCount = 0) const;
+
+    // Library-wide summation for calls that do not name a method (FAST unless changed; thread-safe)
+    static void setDefaultSummationMethod(SummationMethod method);
+    static SummationMethod getDefaultSummationMethod();
+
+    // Robust statistics: trimPercentage percent of the values (half from each end, as in trimData) are
+    // cut by value rather than position. The series is not modified; threadCount 0 uses all cores.
+    double calculateTrimmedMean(double trimPercentage, size_t threadCount = 0) const;
+    double calculateWinsorizedMean(double trimPercentage, size_t threadCount = 0) const;
+    double calculateWinsorizedStandardDeviation(double trimPercentage, size_t threadCount = 0) const;
+
+    // Statistical analysis over the rows of a predicate selection (see IoTDataPredicate.h)
+    double calculateMean(const IoTDataSelection& selection) const;
+    double calculateStandardDeviation(const IoTDataSelection& selection) const;
 
     // Data transformation functions
     void scaleData(double scaleFactor);
-    void normalizeData();
+    void normalizeData(NormalizationMethod method = NormalizationMethod::Z_SCORE);
+    void calibrateData(const IoTDataCalibration& calibration);
 
-    // Data export/import functions
+    // Data export/import functions. Names ending in .gz are written gzip-compressed (binary for .bin.gz,
+    // CSV otherwise); compressed CSV and binary files are imported transparently. A failed import leaves the
+    // series unchanged.
     void exportDataToFile(const std::string& filename) const;
-    void importDataFromFile(const std::string& filename);
+    void exportDataToFile(const std::string& filename, const IoTDataExportOptions& options) const;
+    IoTDataImportReport importDataFromFile(const std::string& filename,
+                                           const IoTDataImportOptions& options = IoTDataImportOptions());
+
+    // Data ordering functions
+    void sortByTimestamp();
 
-    // Data visualization functions
+    // Data visualization functions: a one-line summary on std::cout, or an SVG/PNG chart
+    // (format taken from the .png/.svg extension, or from options; see IoTDataPlot.h)
     void plotData() const;
+    void plotData(const std::string& filename) const;
+    void plotData(const std::string& filename, const IoTDataPlotOptions& options) const;
 
     // Data trimming functions 
     void trimData(double trimPercentage);
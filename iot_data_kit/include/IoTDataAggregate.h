@@ -0,0 +1,65 @@
+// IoTDataAggregate.h
+#ifndef IOT_DATA_AGGREGATE_H
+#define IOT_DATA_AGGREGATE_H
+
+#include "IoTData.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Partial aggregate of a set of values: count, sum, M2 (sum of squared deviations from the mean),
+// minimum and maximum. Aggregates built over chunks, streams or other processes merge associatively
+// (Chan et al.), so one implementation serves serial, parallel and distributed scans.
+// NaN and infinite values are counted but kept out of the moments; the finalizers reject them.
+class IoTDataAggregate {
+private:
+    uint64_t count = 0;
+    uint64_t nanCount = 0;
+    uint64_t infiniteCount = 0;
+    double sum = 0.0;
+    double m2 = 0.0;
+    double minimum = 0.0;
+    double maximum = 0.0;
+
+    IoTDataAggregate(uint64_t count, uint64_t nanCount, uint64_t infiniteCount, double sum, double m2,
+                     double minimum, double maximum);
+
+    static IoTDataAggregate fromChunk(const double* values, size_t count, SummationMethod method);
+
+public:
+    static constexpr size_t kSerializedSize = 4 + 3 * sizeof(uint64_t) + 4 * sizeof(double);
+
+    IoTDataAggregate() = default;
+
+    // Vectorized two-pass build over a column, split across threadCount chunks (0 = hardware concurrency).
+    // Without a method the library default (IoTData::getDefaultSummationMethod) is used.
+    static IoTDataAggregate fromValues(const double* values, size_t count, size_t threadCount = 1);
+    static IoTDataAggregate fromValues(const double* values, size_t count, SummationMethod method,
+                                       size_t threadCount = 1);
+
+    void add(double value);
+    void merge(const IoTDataAggregate& other);
+    void reset();
+
+    // Update on every point appended to series (the aggregate must outlive the series)
+    size_t attach(IoTData& series);
+
+    // Fixed-size native-endian encoding ("IAG1" magic) for shipping partial states between processes
+    std::vector<uint8_t> serialize() const;
+    static IoTDataAggregate deserialize(const uint8_t* bytes, size_t size);
+
+    // Finalizers; these throw the same exceptions as IoTData::calculateMean/calculateStandardDeviation
+    double getMean() const;
+    double getVariance() const;            // Population variance
+    double getStandardDeviation() const;
+    double getMinimum() const;
+    double getMaximum() const;
+
+    uint64_t getCount() const;             // Finite values only
+    uint64_t getNanCount() const;
+    uint64_t getInfiniteCount() const;
+    double getSum() const;
+    double getM2() const;
+};
+
+#endif // IOT_DATA_AGGREGATE_H
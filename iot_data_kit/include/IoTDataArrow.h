@@ -0,0 +1,79 @@
+// IoTDataArrow.h
+#ifndef IOT_DATA_ARROW_H
+#define IOT_DATA_ARROW_H
+
+#include "IoTData.h"
+#include "IoTDataView.h"
+#include <cstdint>
+
+// Apache Arrow C Data Interface (ABI-stable, declared here so no Arrow dependency is needed)
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+extern "C" {
+
+struct ArrowSchema {
+    const char* format;
+    const char* name;
+    const char* metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema* dictionary;
+    void (*release)(struct ArrowSchema*);
+    void* private_data;
+};
+
+struct ArrowArray {
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void** buffers;
+    struct ArrowArray** children;
+    struct ArrowArray* dictionary;
+    void (*release)(struct ArrowArray*);
+    void* private_data;
+};
+
+} // extern "C"
+
+#endif // ARROW_C_DATA_INTERFACE
+
+// Series are exchanged as a struct array with two non-nullable float64 children,
+// "timestamp" and "value".
+class IoTDataArrow {
+public:
+    // Hands the series' columns to the consumer without copying; the series is left empty
+    static void exportSeries(IoTData&& series, ArrowArray* outArray, ArrowSchema* outSchema);
+
+    // Exports borrowed columns; the caller keeps them alive until the consumer releases the array
+    static void exportView(const IoTDataView& view, ArrowArray* outArray, ArrowSchema* outSchema);
+};
+
+// Imported Arrow series. Takes ownership of the array (the source struct is marked released),
+// exposes the columns in place, and releases them on destruction.
+class IoTDataArrowColumns {
+private:
+    ArrowArray array{};
+    IoTDataView columns;
+
+public:
+    IoTDataArrowColumns(ArrowArray* sourceArray, const ArrowSchema* schema);
+    ~IoTDataArrowColumns();
+    IoTDataArrowColumns(const IoTDataArrowColumns&) = delete;
+    IoTDataArrowColumns& operator=(const IoTDataArrowColumns&) = delete;
+
+    // Zero-copy view valid for the lifetime of this object
+    IoTDataView view() const;
+
+    // Copy into an owning series
+    IoTData toIoTData() const;
+};
+
+#endif // IOT_DATA_ARROW_H
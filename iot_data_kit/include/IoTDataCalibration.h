@@ -0,0 +1,52 @@
+// IoTDataCalibration.h
+#ifndef IOT_DATA_CALIBRATION_H
+#define IOT_DATA_CALIBRATION_H
+
+#include <cstddef>
+#include <vector>
+
+enum class CalibrationKind {
+    IDENTITY,
+    AFFINE,
+    POLYNOMIAL,
+    LOOKUP_TABLE
+};
+
+// Per-sensor transform from raw readings (e.g. ADC counts) to calibrated values.
+// Attach one to a series with IoTData::setCalibration to calibrate on ingest.
+class IoTDataCalibration {
+private:
+    CalibrationKind kind = CalibrationKind::IDENTITY;
+    std::vector<double> coefficients;   // Ascending powers (affine: offset, gain)
+    std::vector<double> tableRaw;
+    std::vector<double> tableCalibrated;
+    bool uniformTable = false;          // Raw points evenly spaced: direct indexing instead of search
+
+    double lookup(double raw) const;
+
+    // Snapshots persist a series' ingest calibration
+    friend class IoTDataSnapshot;
+    friend class IoTDataSnapshotReader;
+
+public:
+    IoTDataCalibration() = default;
+
+    // calibrated = gain * raw + offset
+    static IoTDataCalibration affine(double gain, double offset);
+
+    // calibrated = c[0] + c[1] * raw + c[2] * raw^2 + ...
+    static IoTDataCalibration polynomial(const std::vector<double>& coefficients);
+
+    // Piecewise-linear through (raw[i], calibrated[i]); raw must be strictly increasing.
+    // Readings outside the table are clamped to its end values.
+    static IoTDataCalibration lookupTable(const std::vector<double>& raw, const std::vector<double>& calibrated);
+
+    CalibrationKind getKind() const;
+
+    double apply(double raw) const;
+
+    // Vectorized batch form; raw and calibrated may be the same buffer
+    void apply(const double* raw, double* calibrated, size_t count) const;
+};
+
+#endif // IOT_DATA_CALIBRATION_H
@@ -0,0 +1,78 @@
+// IoTDataCatalog.h
+#ifndef IOT_DATA_CATALOG_H
+#define IOT_DATA_CATALOG_H
+
+#include "IoTData.h"
+#include "IoTDataAggregate.h"
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+// What the catalog records about one data file, so queries can be planned without opening it
+struct IoTDataCatalogEntry {
+    std::string file;               // Relative to the catalog directory
+    std::string sensorId;
+    double firstTimestamp = 0.0;    // Earliest and latest timestamp in the file
+    double lastTimestamp = 0.0;
+    uint64_t count = 0;
+    IoTDataAggregate aggregate;     // Value statistics of the whole file
+    uint64_t fileSize = 0;          // Size and modification time when indexed (to detect rewritten files)
+    int64_t modifiedTime = 0;
+};
+
+// Manifest of the data files in one directory, so time-range queries open only the files they need.
+// Layout inside the directory:
+//   catalog.manifest  one entry per data file, rewritten atomically by save
+//   catalog.bloom     Bloom filter over the sensor ids of the manifest, read on its own by
+//                     candidateDirectories to skip directories without loading their manifest
+class IoTDataCatalog {
+private:
+    std::string directory;
+    std::map<std::string, IoTDataCatalogEntry> entries;   // By file
+
+    std::string filePath(const std::string& file) const;
+    void load();
+    IoTDataCatalogEntry describe(const std::string& file, const std::string& sensorId, const IoTData& series) const;
+
+public:
+    // Loads the directory's manifest when there is one
+    explicit IoTDataCatalog(const std::string& directory);
+
+    // Records a file readable by IoTData::importDataFromFile, reading it once. Without a sensor id the file
+    // name up to its first '.' is used (the naming of IoTDataIncrementalExporter).
+    const IoTDataCatalogEntry& addFile(const std::string& file, const std::string& sensorId = "");
+
+    // Records a file just exported from series, without reading it back
+    const IoTDataCatalogEntry& addSeries(const std::string& file, const std::string& sensorId,
+                                         const IoTData& series);
+
+    bool removeFile(const std::string& file);
+
+    // Re-indexes files rewritten since they were recorded and drops deleted ones (returns entries changed)
+    size_t refresh();
+
+    // Writes the Bloom filter, then the manifest, each through a temporary file renamed into place
+    void save() const;
+
+    // Entries of the sensor whose time range overlaps [start, end], by first timestamp
+    std::vector<IoTDataCatalogEntry> findFiles(const std::string& sensorId, double start, double end) const;
+
+    // Points of the sensor in [start, end], reading only the files that overlap it
+    IoTData loadRange(const std::string& sensorId, double start, double end) const;
+
+    // Statistics merged from the manifest alone. Files are the unit: every file overlapping [start, end]
+    // counts in full, so the result is coarse at the edges of the range.
+    IoTDataAggregate aggregateRange(const std::string& sensorId, double start, double end) const;
+
+    bool containsSensor(const std::string& sensorId) const;
+    std::vector<std::string> getSensorIds() const;
+    const std::map<std::string, IoTDataCatalogEntry>& getEntries() const;
+    const std::string& getDirectory() const;
+
+    // Directories under root (root included) with a catalog whose Bloom filter may contain sensorId.
+    // Only the filter files are read.
+    static std::vector<std::string> candidateDirectories(const std::string& root, const std::string& sensorId);
+};
+
+#endif // IOT_DATA_CATALOG_H
@@ -0,0 +1,93 @@
+// IoTDataCompactSeries.h
+#ifndef IOT_DATA_COMPACT_SERIES_H
+#define IOT_DATA_COMPACT_SERIES_H
+
+#include "IoTData.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Append-only timestamp column stored as blocks of kBlockSize points. Each block keeps its first and last
+// timestamp and encodes the points as integer ticks (1, 1e3, 1e6 or 1e9 per unit, whichever reproduces
+// every timestamp exactly): a frame-of-reference tick plus bit-packed deltas above the block's smallest
+// delta. Blocks that no tick resolution reproduces, or whose deltas need more than 56 bits, fall back to raw
+// doubles and take as much memory as an uncompressed column. The open last block is raw.
+class IoTDataTimestampColumn {
+public:
+    static constexpr size_t kBlockSize = 128;
+
+private:
+    struct Block {
+        double first;
+        double last;
+        double scale;            // Ticks per unit; 0 for a raw block
+        int64_t base;            // Tick of the first point
+        int64_t minimumDelta;
+        size_t offset;           // First packed word
+        uint32_t count;
+        uint32_t bitWidth;       // Bits per packed delta (64 for raw blocks)
+    };
+
+    std::vector<Block> blocks;
+    std::vector<uint64_t> packed;
+    std::vector<double> tail;
+    size_t rowCount = 0;
+
+    void encodeBlock(const double* timestamps, size_t count);
+
+public:
+    IoTDataTimestampColumn() = default;
+    IoTDataTimestampColumn(const double* timestamps, size_t count);
+
+    void append(double timestamp);
+    void clear();
+    size_t size() const;
+    bool empty() const;
+
+    double at(size_t index) const;
+
+    // Blocks cover kBlockSize points each; the last one may be partial (and is the open tail)
+    size_t getBlockCount() const;
+    size_t decodeBlock(size_t block, double* output) const;
+    std::vector<double> decode() const;
+
+    // First index whose timestamp is not less than timestamp (size() if none), for ascending columns.
+    // Block first/last values narrow the search to one block before anything is decoded.
+    size_t lowerBound(double timestamp) const;
+
+    // Block containing lowerBound(timestamp), from the block last values alone (getBlockCount() if none)
+    size_t lowerBoundBlock(double timestamp) const;
+
+    // Heap bytes held by the encoded column
+    size_t memoryUsage() const;
+};
+
+// Read-mostly series whose timestamps are held in an IoTDataTimestampColumn (values stay plain doubles).
+// Intended for retained history: convert with toIoTData for operations not offered here.
+class IoTDataCompactSeries {
+private:
+    std::vector<double> data;
+    IoTDataTimestampColumn timestamps;
+
+public:
+    IoTDataCompactSeries() = default;
+    explicit IoTDataCompactSeries(const IoTData& series);
+
+    void appendData(double newData, double timestamp);
+    void clearData();
+    size_t getDataSize() const;
+
+    double getValue(size_t index) const;
+    double getTimestamp(size_t index) const;
+    const IoTDataTimestampColumn& getTimestamps() const;
+
+    // Same results as IoTData::interpolateData; LINEAR and NEAREST_NEIGHBOR decode only the blocks the
+    // requested timestamps fall into (ascending requests decode each block at most once)
+    std::vector<double> interpolateData(const std::vector<double>& newTimestamps,
+                                        InterpolationMethod method = InterpolationMethod::LINEAR) const;
+
+    IoTData toIoTData() const;
+    size_t memoryUsage() const;
+};
+
+#endif // IOT_DATA_COMPACT_SERIES_H
@@ -7,22 +7,22 @@
 
 class IoTDataException : public std::runtime_error {
 public:
-    explicit IoTDataException(const std::string& message) : std::runtime_error(message) {}
+    explicit IoTDataException(const std::string& message);
 };
 
 class IoTDataEmptyException : public IoTDataException {
 public:
-    explicit IoTDataEmptyException(const std::string& message) : IoTDataException(message) {}
+    explicit IoTDataEmptyException(const std::string& message);
 };
 
 class IoTDataInsufficientException : public IoTDataException {
 public:
-    explicit IoTDataInsufficientException(const std::string& message) : IoTDataException(message) {}
+    explicit IoTDataInsufficientException(const std::string& message);
 };
 
 class IoTDataFileException : public IoTDataException {
 public:
-    explicit IoTDataFileException(const std::string& message) : IoTDataException(message) {}
+    explicit IoTDataFileException(const std::string& message);
 };
 
 #endif // IOT_DATA_EXCEPTION_H
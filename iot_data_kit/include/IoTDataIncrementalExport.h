@@ -0,0 +1,53 @@
+// IoTDataIncrementalExport.h
+#ifndef IOT_DATA_INCREMENTAL_EXPORT_H
+#define IOT_DATA_INCREMENTAL_EXPORT_H
+
+#include "IoTData.h"
+#include "IoTDataStore.h"
+#include <cstdint>
+#include <map>
+#include <string>
+
+// Appends only the points added since the previous export of each series.
+// Layout inside the export directory:
+//   <series>.csv / <series>.bin  delta log appended on every export
+//   <series>.snap                full snapshot written by compaction
+//   watermarks.csv               per-series watermark, rewritten atomically after each export
+class IoTDataIncrementalExporter {
+private:
+    struct Watermark {
+        uint64_t exportedCount = 0;    // Points of the series covered by snapshot + delta log
+        double lastTimestamp = 0.0;    // Timestamp of the last exported point
+        uint64_t deltaExports = 0;     // Delta exports since the last compaction
+    };
+
+    std::string directory;
+    ExportFormat format;
+    size_t compactionInterval = 0;
+    std::map<std::string, Watermark> watermarks;
+
+    std::string seriesPath(const std::string& seriesId, const std::string& extension) const;
+    void loadWatermarks();
+    void saveWatermarks() const;
+    size_t firstUnexported(const Watermark& watermark, const IoTData& series) const;
+
+public:
+    IoTDataIncrementalExporter(const std::string& directory, ExportFormat format = ExportFormat::BINARY);
+
+    // Compact automatically after this many delta exports of a series (0 disables)
+    void setCompactionInterval(size_t deltaExports);
+
+    // Export functions (return the number of points written)
+    size_t exportSeries(const std::string& seriesId, const IoTData& series);
+    size_t exportStore(const IoTDataStore& store);
+
+    // Replace a series' delta log with a full snapshot
+    void compact(const std::string& seriesId, const IoTData& series);
+
+    // Rebuild a series from its snapshot and delta log
+    IoTData restore(const std::string& seriesId) const;
+
+    uint64_t getExportedCount(const std::string& seriesId) const;
+};
+
+#endif // IOT_DATA_INCREMENTAL_EXPORT_H
@@ -0,0 +1,55 @@
+// IoTDataMultiChannel.h
+#ifndef IOT_DATA_MULTI_CHANNEL_H
+#define IOT_DATA_MULTI_CHANNEL_H
+
+#include "IoTData.h"
+#include "IoTDataView.h"
+#include <string>
+#include <vector>
+
+// Vector-valued series (accelerometer xyz, multi-channel IMU, ...) in structure-of-arrays layout:
+// one timestamp column shared by N value columns, so per-point kernels vectorize along time.
+class IoTDataMultiChannel {
+private:
+    std::vector<std::string> channelNames;
+    std::vector<double> timestamps;
+    std::vector<std::vector<double>> channels;
+
+    void checkChannel(size_t channel) const;
+    std::vector<const double*> channelColumns() const;
+
+public:
+    // Constructor
+    explicit IoTDataMultiChannel(size_t channelCount);
+    explicit IoTDataMultiChannel(const std::vector<std::string>& channelNames);
+
+    // Basic data manipulation functions (values holds one reading per channel)
+    void appendData(const double* values, double timestamp);
+    void appendData(const std::vector<double>& values, double timestamp);
+    void clearData();
+    size_t getDataSize() const;
+    size_t getChannelCount() const;
+    const std::string& getChannelName(size_t channel) const;
+    size_t findChannel(const std::string& name) const;
+
+    // Zero-copy access to one channel together with the shared timestamps
+    IoTDataView channelView(size_t channel) const;
+
+    // Copy one channel into a scalar series
+    IoTData toIoTData(size_t channel) const;
+
+    // Per-channel statistics
+    double calculateMean(size_t channel) const;
+    double calculateStandardDeviation(size_t channel) const;
+    std::vector<double> calculateChannelMeans() const;
+    std::vector<double> calculateChannelStandardDeviations() const;
+
+    // Cross-channel kernels, one result per timestamp
+    std::vector<double> calculateMagnitude() const;
+    std::vector<double> calculateProjection(const std::vector<double>& axis) const;
+
+    // Sum over time of the product of two channels
+    double calculateDotProduct(size_t first, size_t second) const;
+};
+
+#endif // IOT_DATA_MULTI_CHANNEL_H
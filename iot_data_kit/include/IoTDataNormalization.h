@@ -0,0 +1,41 @@
+// IoTDataNormalization.h
+#ifndef IOT_DATA_NORMALIZATION_H
+#define IOT_DATA_NORMALIZATION_H
+
+#include "IoTData.h"
+#include <cstddef>
+
+// Streaming counterpart of IoTData::normalizeData: statistics are updated per appended point
+// (Welford for Z_SCORE, running extremes for MIN_MAX). ROBUST needs the whole series and is batch-only.
+class IoTDataRunningNormalizer {
+private:
+    NormalizationMethod method;
+    size_t count = 0;
+    double mean = 0.0;
+    double m2 = 0.0;
+    double minimum = 0.0;
+    double maximum = 0.0;
+
+public:
+    explicit IoTDataRunningNormalizer(NormalizationMethod method = NormalizationMethod::Z_SCORE);
+
+    void add(double value);
+    void reset();
+
+    // Update on every point appended to series
+    size_t attach(IoTData& series);
+
+    // Also append each point to normalized, scaled with the statistics up to and including it
+    size_t attach(IoTData& series, IoTData& normalized);
+
+    // Normalize with the current statistics (zero spread only centres the value)
+    double normalize(double value) const;
+
+    size_t getCount() const;
+    double getMean() const;
+    double getStandardDeviation() const;
+    double getMinimum() const;
+    double getMaximum() const;
+};
+
+#endif // IOT_DATA_NORMALIZATION_H
@@ -0,0 +1,56 @@
+// IoTDataPlot.h
+#ifndef IOT_DATA_PLOT_H
+#define IOT_DATA_PLOT_H
+
+#include "IoTDataStore.h"
+#include "IoTDataView.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum class PlotFormat {
+    SVG,
+    PNG
+};
+
+struct IoTDataPlotOptions {
+    size_t width = 800;
+    size_t height = 300;
+    PlotFormat format = PlotFormat::SVG;
+    std::string title;                  // SVG only; PNG charts carry no text
+    uint32_t backgroundColor = 0xFFFFFF;
+    uint32_t axisColor = 0x888888;
+    uint32_t lineColor = 0x1F77B4;
+};
+
+// First, last, minimum and maximum value of the points falling into one pixel column.
+// Drawing these four per column gives the same line raster as drawing every point.
+struct IoTDataPlotColumn {
+    double first;
+    double last;
+    double minimum;
+    double maximum;
+    size_t points;
+};
+
+// Line chart renderer. Series are reduced to one IoTDataPlotColumn per horizontal pixel before
+// drawing, so rendering cost is one pass over the points plus the image size.
+class IoTDataPlot {
+public:
+    // Per-pixel downsampling over the series' time range (NaN values are skipped)
+    static std::vector<IoTDataPlotColumn> downsample(const IoTDataView& view, size_t columns);
+
+    static std::string renderSvg(const IoTDataView& view, const IoTDataPlotOptions& options = IoTDataPlotOptions());
+    static std::vector<uint8_t> renderPng(const IoTDataView& view,
+                                          const IoTDataPlotOptions& options = IoTDataPlotOptions());
+
+    // Render to a file in options.format with a single buffered write
+    static void render(const IoTDataView& view, const std::string& filename,
+                       const IoTDataPlotOptions& options = IoTDataPlotOptions());
+
+    // Render every series to <directory>/<series id>.svg or .png in parallel (0 = hardware concurrency)
+    static void renderStore(const IoTDataStore& store, const std::string& directory,
+                            const IoTDataPlotOptions& options = IoTDataPlotOptions(), size_t threadCount = 0);
+};
+
+#endif // IOT_DATA_PLOT_H
@@ -0,0 +1,106 @@
+// IoTDataPredicate.h
+#ifndef IOT_DATA_PREDICATE_H
+#define IOT_DATA_PREDICATE_H
+
+#include "IoTData.h"
+#include "IoTDataView.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Bitmask with one bit per row of a series; bit i set means row i is selected.
+class IoTDataSelection {
+private:
+    std::vector<uint64_t> words;
+    size_t rowCount = 0;
+
+    void clearTail();
+
+    // Index of the lowest set bit; bits must be non-zero
+    static size_t lowestSetBit(uint64_t bits);
+
+public:
+    explicit IoTDataSelection(size_t rows = 0, bool selected = false);
+
+    size_t size() const;
+    size_t count() const;
+    bool test(size_t index) const;
+    void set(size_t index, bool selected = true);
+
+    // Combination operators (selections must cover the same number of rows)
+    IoTDataSelection& operator&=(const IoTDataSelection& other);
+    IoTDataSelection& operator|=(const IoTDataSelection& other);
+    void invert();
+
+    // Selection vector of the selected row indices
+    std::vector<uint32_t> toIndices() const;
+
+    // Raw word access for kernels consuming the mask directly
+    const uint64_t* wordData() const { return words.data(); }
+    uint64_t* wordData() { return words.data(); }
+    size_t wordCount() const { return words.size(); }
+
+    // Calls f(index) for each selected row in ascending order
+    template <typename F>
+    void forEachSelected(F f) const {
+        for (size_t w = 0; w < words.size(); ++w) {
+            uint64_t bits = words[w];
+            while (bits != 0) {
+                f(w * 64 + lowestSetBit(bits));
+                bits &= bits - 1;
+            }
+        }
+    }
+};
+
+enum class PredicateColumn {
+    VALUE,
+    TIMESTAMP
+};
+
+// Composable predicate over the value and timestamp columns.
+// Leaves are inclusive ranges; evaluation produces an IoTDataSelection without copying the series.
+class IoTDataPredicate {
+private:
+    enum class NodeType { RANGE, AND, OR, NOT, ALL };
+
+    struct Node {
+        NodeType type;
+        PredicateColumn column = PredicateColumn::VALUE;
+        double lower = 0.0;
+        double upper = 0.0;
+        std::shared_ptr<const Node> left;
+        std::shared_ptr<const Node> right;
+    };
+
+    std::shared_ptr<const Node> root;
+
+    explicit IoTDataPredicate(std::shared_ptr<const Node> node);
+    static IoTDataPredicate range(PredicateColumn column, double lower, double upper);
+    static IoTDataSelection evaluateNode(const Node& node, const IoTDataView& view,
+                                         const std::vector<IoTDataBlockSummary>* summaries);
+
+public:
+    // Leaf predicates
+    static IoTDataPredicate all();
+    static IoTDataPredicate valueBetween(double lower, double upper);
+    static IoTDataPredicate valueAbove(double threshold);
+    static IoTDataPredicate valueBelow(double threshold);
+    static IoTDataPredicate absValueAtMost(double threshold);
+    static IoTDataPredicate timeBetween(double start, double end);
+    static IoTDataPredicate timeBefore(double end);
+    static IoTDataPredicate timeFrom(double start);
+
+    // Combinators
+    IoTDataPredicate operator&&(const IoTDataPredicate& other) const;
+    IoTDataPredicate operator||(const IoTDataPredicate& other) const;
+    IoTDataPredicate operator!() const;
+
+    // Evaluation into a bitmask over the view's rows
+    IoTDataSelection evaluate(const IoTDataView& view) const;
+
+    // Same result; value ranges use the series' block summaries to fill or skip whole blocks
+    IoTDataSelection evaluate(const IoTData& series) const;
+};
+
+#endif // IOT_DATA_PREDICATE_H
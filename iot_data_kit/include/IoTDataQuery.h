@@ -0,0 +1,98 @@
+// IoTDataQuery.h
+#ifndef IOT_DATA_QUERY_H
+#define IOT_DATA_QUERY_H
+
+#include "IoTData.h"
+#include "IoTDataStore.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+enum class QueryOpcode : uint8_t {
+    RANGE = 1,
+    ROLLUP = 2,
+    INTERPOLATE = 3
+};
+
+struct IoTDataRollupBucket {
+    double start;
+    uint64_t count;
+    double mean;
+    double min;
+    double max;
+};
+
+struct IoTDataQueryResponse {
+    uint32_t requestId = 0;
+    QueryOpcode opcode = QueryOpcode::RANGE;
+    std::string error;                          // Empty on success
+    std::vector<double> values;                 // RANGE and INTERPOLATE results
+    std::vector<double> timestamps;             // RANGE results
+    std::vector<IoTDataRollupBucket> buckets;   // ROLLUP results
+};
+
+// Embedded query server over a Unix domain socket, driven by a single-threaded epoll loop.
+// Clients may pipeline any number of requests; responses are returned in request order. A result that would
+// not fit in one 64 MB frame is answered with an error instead.
+class IoTDataQueryServer {
+private:
+    const IoTDataStore& store;
+    std::mutex* storeMutex;
+    std::string socketPath;
+    int listenFd = -1;
+    int epollFd = -1;
+    int wakeFd = -1;
+    std::atomic<bool> running{true};
+
+    void processFrame(const unsigned char* frame, size_t length, std::vector<unsigned char>& output) const;
+    void closeDescriptors();
+
+public:
+    // storeMutex, when given, is held while a batch of requests reads the store
+    IoTDataQueryServer(const IoTDataStore& store, const std::string& socketPath, std::mutex* storeMutex = nullptr);
+    ~IoTDataQueryServer();
+    IoTDataQueryServer(const IoTDataQueryServer&) = delete;
+    IoTDataQueryServer& operator=(const IoTDataQueryServer&) = delete;
+
+    // Serve until stop() is called (from any thread)
+    void run();
+    void stop();
+};
+
+// Client for IoTDataQueryServer. Requests are queued and sent in one write by flush(),
+// then their responses are collected in order with receive().
+class IoTDataQueryClient {
+private:
+    int socketFd = -1;
+    uint32_t nextRequestId = 1;
+    size_t outstanding = 0;
+    std::vector<unsigned char> pendingOutput;
+    std::vector<unsigned char> input;
+    size_t inputOffset = 0;
+
+    IoTDataQueryResponse receiveChecked(QueryOpcode expected);
+
+public:
+    explicit IoTDataQueryClient(const std::string& socketPath);
+    ~IoTDataQueryClient();
+    IoTDataQueryClient(const IoTDataQueryClient&) = delete;
+    IoTDataQueryClient& operator=(const IoTDataQueryClient&) = delete;
+
+    // Pipelined requests (return the request id echoed in the response)
+    uint32_t queueRange(const std::string& seriesId, double start, double end);
+    uint32_t queueRollup(const std::string& seriesId, double start, double end, double bucketWidth);
+    uint32_t queueInterpolate(const std::string& seriesId, const std::vector<double>& newTimestamps,
+                              InterpolationMethod method = InterpolationMethod::LINEAR);
+    void flush();
+    IoTDataQueryResponse receive();
+
+    // Synchronous convenience calls
+    IoTData range(const std::string& seriesId, double start, double end);
+    std::vector<IoTDataRollupBucket> rollup(const std::string& seriesId, double start, double end, double bucketWidth);
+    std::vector<double> interpolate(const std::string& seriesId, const std::vector<double>& newTimestamps,
+                                    InterpolationMethod method = InterpolationMethod::LINEAR);
+};
+
+#endif // IOT_DATA_QUERY_H
@@ -0,0 +1,116 @@
+// IoTDataRules.h
+#ifndef IOT_DATA_RULES_H
+#define IOT_DATA_RULES_H
+
+#include "IoTData.h"
+#include <vector>
+#include <string>
+#include <functional>
+#include <unordered_map>
+
+enum class RuleAggregate {
+    MEAN,
+    MIN,
+    MAX,
+    LAST,
+    RATE_OF_CHANGE
+};
+
+enum class RuleComparison {
+    GREATER,
+    GREATER_EQUAL,
+    LESS,
+    LESS_EQUAL
+};
+
+// Condition such as "mean over 300s > 80 for 3 consecutive windows".
+// A window of 0 evaluates the condition on every sample instead of per tumbling window.
+struct IoTDataRule {
+    std::string name;
+    std::string target;             // Series id, or tag when targetIsTag is set
+    bool targetIsTag = false;
+    RuleAggregate aggregate = RuleAggregate::MEAN;
+    double window = 0.0;            // Tumbling window length in timestamp units
+    RuleComparison comparison = RuleComparison::GREATER;
+    double threshold = 0.0;
+    size_t consecutive = 1;         // Consecutive matching windows required to fire
+};
+
+struct IoTDataAlert {
+    size_t ruleId;
+    std::string ruleName;
+    std::string seriesId;
+    double timestamp;               // End of the window (or sample time) that fired
+    double value;                   // Aggregate value that matched
+};
+
+class IoTDataRuleEngine {
+public:
+    using AlertHandler = std::function<void(const IoTDataAlert&)>;
+
+private:
+    // Binding of one rule to one series, with its consecutive-match counter
+    struct RuleBinding {
+        size_t ruleId;
+        size_t matches = 0;
+    };
+
+    // Shared per-(series, window) aggregate; every rule with the same window reuses it
+    struct WindowState {
+        double window;
+        double windowStart = 0.0;
+        bool open = false;
+        size_t count = 0;
+        double sum = 0.0;
+        double min = 0.0;
+        double max = 0.0;
+        double first = 0.0;
+        double last = 0.0;
+        double firstTimestamp = 0.0;
+        double lastTimestamp = 0.0;
+        std::vector<RuleBinding> bindings;
+    };
+
+    struct SeriesState {
+        std::string id;
+        std::vector<std::string> tags;
+        bool hasPrevious = false;
+        double previousValue = 0.0;
+        double previousTimestamp = 0.0;
+        std::vector<RuleBinding> sampleBindings;  // Rules with window == 0
+        std::vector<WindowState> windows;
+    };
+
+    std::vector<IoTDataRule> rules;
+    std::vector<SeriesState> series;
+    std::unordered_map<std::string, size_t> seriesIndex;
+    std::unordered_map<std::string, std::vector<size_t>> tagRules;
+    std::unordered_map<std::string, std::vector<size_t>> tagSeries;   // Indices of the series carrying each tag
+    std::vector<IoTDataAlert> pendingAlerts;
+    AlertHandler alertHandler;
+
+    size_t findOrCreateSeries(const std::string& seriesId);
+    void bindRule(SeriesState& state, size_t ruleId);
+    void ingestSeries(SeriesState& state, double value, double timestamp);
+    void closeWindow(SeriesState& state, WindowState& window, size_t skippedWindows);
+    void evaluate(SeriesState& state, RuleBinding& binding, double aggregateValue, double timestamp);
+
+public:
+    // Constructor (alerts are queued for drainAlerts when no handler is given)
+    explicit IoTDataRuleEngine(AlertHandler handler = nullptr);
+
+    // Series registration and ingest hookup
+    void registerSeries(const std::string& seriesId, const std::vector<std::string>& tags = {});
+    size_t attach(const std::string& seriesId, IoTData& seriesData);
+    void ingest(const std::string& seriesId, double value, double timestamp);
+
+    // Rule management
+    size_t addRule(const IoTDataRule& rule);
+    size_t getRuleCount() const;
+    size_t getSharedAggregateCount() const;
+
+    // Alert retrieval
+    std::vector<IoTDataAlert> drainAlerts();
+};
+
+#endif // IOT_DATA_RULES_H
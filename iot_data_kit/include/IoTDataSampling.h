@@ -0,0 +1,71 @@
+// IoTDataSampling.h
+#ifndef IOT_DATA_SAMPLING_H
+#define IOT_DATA_SAMPLING_H
+
+#include "IoTData.h"
+#include "IoTDataView.h"
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+// Approximate result with a two-sided confidence interval
+struct IoTDataEstimate {
+    double value;
+    double lower;
+    double upper;
+    double confidence;
+    size_t sampleSize;
+};
+
+// Fixed-size uniform sample of an unbounded stream (Li's Algorithm L).
+// Can be fed directly from IoTData::addAppendListener.
+class IoTDataReservoir {
+private:
+    size_t capacity;
+    size_t seen = 0;
+    size_t nextReplacement = 0;
+    double weight = 0.0;
+    std::mt19937_64 rng;
+    std::vector<double> values;
+    std::vector<double> timestamps;
+
+    void scheduleNextReplacement();
+
+public:
+    explicit IoTDataReservoir(size_t capacity, uint64_t seed = std::mt19937_64::default_seed);
+
+    void add(double value, double timestamp);
+    size_t getSeenCount() const;
+    size_t getSampleSize() const;
+
+    // Sampled points in time order
+    IoTData toIoTData() const;
+};
+
+class IoTDataSampler {
+private:
+    std::mt19937_64 rng;
+
+    std::vector<size_t> sampleIndices(size_t populationSize, size_t sampleSize);
+    std::vector<double> sampleValues(const IoTDataView& view, size_t sampleSize);
+
+public:
+    explicit IoTDataSampler(uint64_t seed = std::mt19937_64::default_seed);
+
+    // Sampling functions (results keep the original time order)
+    IoTData reservoirSample(const IoTDataView& view, size_t sampleSize);
+    IoTData bernoulliSample(const IoTDataView& view, double probability);
+    IoTData stratifiedSample(const IoTDataView& view, size_t strata, size_t samplesPerStratum);
+
+    // Streaming sampling of a timestamp,value file without loading it
+    IoTData reservoirSampleFile(const std::string& filename, size_t sampleSize);
+
+    // Approximate analytics over a uniform sample of sampleSize points
+    IoTDataEstimate approximateMean(const IoTDataView& view, size_t sampleSize, double confidence = 0.95);
+    IoTDataEstimate approximateStandardDeviation(const IoTDataView& view, size_t sampleSize, double confidence = 0.95);
+    IoTDataEstimate approximateQuantile(const IoTDataView& view, double quantile, size_t sampleSize,
+                                        double confidence = 0.95);
+};
+
+#endif // IOT_DATA_SAMPLING_H
@@ -0,0 +1,68 @@
+// IoTDataSharedRing.h
+#ifndef IOT_DATA_SHARED_RING_H
+#define IOT_DATA_SHARED_RING_H
+
+#include "IoTData.h"
+#include "IoTDataView.h"
+#include <cstdint>
+#include <string>
+
+// Points published by the writer between two sequence numbers. Because the ring wraps,
+// the range is exposed as at most two contiguous column segments.
+struct IoTDataRingBatch {
+    uint64_t firstSequence = 0;
+    uint64_t count = 0;
+    IoTDataView segments[2];
+    size_t segmentCount = 0;
+};
+
+// POSIX shared-memory ring of points with a single writer and any number of readers.
+// The writer publishes with a release store of the write sequence; readers never block it.
+class IoTDataSharedRing {
+private:
+    struct RingHeader;
+
+    std::string name;
+    bool owner = false;
+    void* mapping = nullptr;
+    size_t mappingSize = 0;
+    RingHeader* header = nullptr;
+    double* values = nullptr;
+    double* timestamps = nullptr;
+    uint64_t capacity = 0;
+    uint64_t readSequence = 0;
+    uint64_t lostCount = 0;
+
+    IoTDataSharedRing(const std::string& name, bool owner);
+    void map(int fd, size_t size, bool writable);
+
+public:
+    // Writer side: creates the shared-memory object. An existing one of that name is unlinked first, so
+    // readers still attached to it keep their mapping but see no further points.
+    static IoTDataSharedRing create(const std::string& name, size_t capacity);
+
+    // Reader side: opens an existing ring read-only, starting at the newest or oldest retained point
+    static IoTDataSharedRing open(const std::string& name, bool fromOldest = false);
+
+    IoTDataSharedRing(IoTDataSharedRing&& other) noexcept;
+    IoTDataSharedRing& operator=(IoTDataSharedRing&& other) noexcept;
+    IoTDataSharedRing(const IoTDataSharedRing&) = delete;
+    IoTDataSharedRing& operator=(const IoTDataSharedRing&) = delete;
+    ~IoTDataSharedRing();
+
+    // Writer functions
+    void appendData(double newData, double timestamp);
+    size_t attach(IoTData& series);
+    void unlink();
+
+    // Reader functions (zero-copy; validate a batch with isIntact after consuming it)
+    IoTDataRingBatch readAvailable(size_t maxPoints = SIZE_MAX);
+    bool isIntact(const IoTDataRingBatch& batch) const;
+    size_t readInto(IoTData& target, size_t maxPoints = SIZE_MAX);
+
+    uint64_t getWriteSequence() const;
+    uint64_t getLostCount() const;
+    size_t getCapacity() const;
+};
+
+#endif // IOT_DATA_SHARED_RING_H
@@ -0,0 +1,142 @@
+// IoTDataSketch.h
+#ifndef IOT_DATA_SKETCH_H
+#define IOT_DATA_SKETCH_H
+
+#include "IoTData.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Count-min sketch over discrete sensor values. Estimates never undercount and
+// overcount by at most e/width * total with probability 1 - exp(-depth).
+class IoTDataCountMinSketch {
+private:
+    size_t width;
+    size_t depth;
+    uint64_t seed;
+    uint64_t totalCount = 0;
+    std::vector<uint64_t> counters;
+
+    size_t cell(size_t row, uint64_t hash1, uint64_t hash2) const;
+
+public:
+    explicit IoTDataCountMinSketch(size_t width = 2048, size_t depth = 4, uint64_t seed = 0);
+    static IoTDataCountMinSketch fromErrorBounds(double epsilon, double delta, uint64_t seed = 0);
+
+    void add(double value, uint64_t count = 1);
+    uint64_t estimate(double value) const;
+    uint64_t getTotalCount() const;
+
+    // Sketches with the same dimensions and seed merge by adding counters
+    void merge(const IoTDataCountMinSketch& other);
+    void clear();
+
+    // Native-endian encoding ("ICM1" magic, dimensions, seed, counters) for merging across processes
+    std::vector<uint8_t> serialize() const;
+    static IoTDataCountMinSketch deserialize(const uint8_t* bytes, size_t size);
+
+    size_t getWidth() const;
+    size_t getDepth() const;
+    uint64_t getSeed() const;
+    const std::vector<uint64_t>& getCounters() const;
+};
+
+// SpaceSaving top-k tracker: a fixed number of counters kept in a min-heap
+class IoTDataHeavyHitters {
+public:
+    struct Entry {
+        double value;
+        uint64_t count;   // Upper bound of the true frequency
+        uint64_t error;   // count - error is a lower bound
+    };
+
+private:
+    size_t capacity;
+    std::vector<Entry> heap;
+    std::unordered_map<uint64_t, size_t> positions;
+
+    void siftUp(size_t index);
+    void siftDown(size_t index);
+    void swapEntries(size_t a, size_t b);
+
+public:
+    explicit IoTDataHeavyHitters(size_t capacity = 64);
+
+    void add(double value, uint64_t count = 1);
+    std::vector<Entry> topK(size_t k) const;
+    size_t getCapacity() const;
+
+    // Mergeable SpaceSaving: counts of values missing on one side are bounded by that side's minimum
+    void merge(const IoTDataHeavyHitters& other);
+};
+
+// Ring of count-min sketches, one per fixed-width time bucket, for frequency queries over time ranges
+class IoTDataTimeBucketedSketch {
+private:
+    double bucketWidth;
+    std::vector<IoTDataCountMinSketch> buckets;
+    std::vector<int64_t> bucketIds;   // Absolute bucket number held by each slot (INT64_MIN when unused)
+
+public:
+    IoTDataTimeBucketedSketch(double bucketWidth, size_t bucketCount, size_t width = 1024, size_t depth = 4);
+
+    // Points older than the retained buckets, or with a non-finite or out-of-range timestamp, are ignored
+    void add(double value, double timestamp, uint64_t count = 1);
+
+    // Estimate over all retained buckets overlapping [start, end]
+    uint64_t estimate(double value, double start, double end) const;
+    IoTDataCountMinSketch rangeSketch(double start, double end) const;
+};
+
+// Frequency tracking for discrete-valued series, updated from IoTData::appendData
+class IoTDataFrequencyTracker {
+private:
+    IoTDataCountMinSketch sketch;
+    IoTDataHeavyHitters heavyHitters;
+    IoTDataTimeBucketedSketch timeBuckets;
+
+public:
+    IoTDataFrequencyTracker(double bucketWidth, size_t bucketCount, size_t topKCapacity = 64);
+
+    void add(double value, double timestamp);
+    size_t attach(IoTData& series);
+
+    uint64_t estimateFrequency(double value) const;
+    uint64_t estimateFrequency(double value, double start, double end) const;
+    std::vector<IoTDataHeavyHitters::Entry> topK(size_t k) const;
+
+    const IoTDataCountMinSketch& getSketch() const;
+    const IoTDataHeavyHitters& getHeavyHitters() const;
+};
+
+// Bloom filter over string keys (e.g. sensor ids): never a false negative, false positives at the rate
+// chosen through fromExpectedCount
+class IoTDataBloomFilter {
+private:
+    size_t bitCount;
+    size_t hashCount;
+    uint64_t seed;
+    std::vector<uint64_t> bits;
+
+public:
+    // hashCount is between 1 and 64
+    explicit IoTDataBloomFilter(size_t bitCount = 8192, size_t hashCount = 4, uint64_t seed = 0);
+    static IoTDataBloomFilter fromExpectedCount(size_t count, double falsePositiveRate, uint64_t seed = 0);
+
+    void add(const std::string& key);
+    bool mightContain(const std::string& key) const;
+
+    // Filters with the same dimensions and seed merge by OR-ing bits
+    void merge(const IoTDataBloomFilter& other);
+    void clear();
+
+    // Native-endian encoding ("IBF1" magic, dimensions, seed, bits)
+    std::vector<uint8_t> serialize() const;
+    static IoTDataBloomFilter deserialize(const uint8_t* bytes, size_t size);
+
+    size_t getBitCount() const;
+    size_t getHashCount() const;
+};
+
+#endif // IOT_DATA_SKETCH_H
@@ -0,0 +1,73 @@
+// IoTDataSnapshot.h
+#ifndef IOT_DATA_SNAPSHOT_H
+#define IOT_DATA_SNAPSHOT_H
+
+#include "IoTData.h"
+#include "IoTDataStore.h"
+#include "IoTDataView.h"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Binary snapshot of one or more series, including cached spline coefficients, duplicate-resolution
+// state and the ingest calibration. Columns are 8-byte aligned in native byte order so
+// a mapped snapshot can be read in place.
+class IoTDataSnapshot {
+private:
+    static void write(const std::vector<std::pair<std::string, const IoTData*>>& series, const std::string& filename,
+                      size_t threadCount);
+
+public:
+    // Save functions (store snapshots write series sections in parallel)
+    static void save(const IoTData& series, const std::string& filename);
+    static void save(const IoTDataStore& store, const std::string& filename, size_t threadCount = 0);
+
+    // Eager restore functions
+    static IoTData load(const std::string& filename);
+    static void restore(IoTDataStore& store, const std::string& filename);
+};
+
+// Memory-mapped snapshot; only the directory is parsed on open and column pages are
+// faulted in when a series is viewed or loaded.
+class IoTDataSnapshotReader {
+public:
+    struct SeriesEntry {
+        uint64_t count;
+        uint64_t valuesOffset;
+        uint64_t timestampsOffset;
+        uint64_t splineCount;
+        uint64_t splineOffset;
+        uint32_t duplicatePolicy;
+        std::vector<std::pair<size_t, size_t>> recentDuplicateCounts;
+        std::shared_ptr<const IoTDataCalibration> calibration;   // Null when readings are stored as-is
+    };
+
+private:
+    const unsigned char* mapping = nullptr;
+    size_t mappingSize = 0;
+    std::map<std::string, SeriesEntry> directory;
+
+    const SeriesEntry& findEntry(const std::string& seriesId) const;
+    void parseDirectory();
+    static std::shared_ptr<const IoTDataCalibration> readCalibration(const unsigned char* base, size_t size,
+                                                                     size_t& cursor);
+
+public:
+    explicit IoTDataSnapshotReader(const std::string& filename);
+    ~IoTDataSnapshotReader();
+    IoTDataSnapshotReader(const IoTDataSnapshotReader&) = delete;
+    IoTDataSnapshotReader& operator=(const IoTDataSnapshotReader&) = delete;
+
+    std::vector<std::string> getSeriesIds() const;
+    size_t getSeriesSize(const std::string& seriesId) const;
+
+    // Zero-copy view valid for the reader's lifetime
+    IoTDataView view(const std::string& seriesId) const;
+
+    // Materialize a series, including its cached state
+    IoTData load(const std::string& seriesId) const;
+};
+
+#endif // IOT_DATA_SNAPSHOT_H
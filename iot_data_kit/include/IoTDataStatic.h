@@ -0,0 +1,221 @@
+// IoTDataStatic.h
+#ifndef IOT_DATA_STATIC_H
+#define IOT_DATA_STATIC_H
+
+#include <cmath>
+#include <cstddef>
+
+// Header-only, fixed-capacity series for memory-constrained devices. Storage is inline (no heap),
+// nothing throws, so it builds with -fno-exceptions, and appendData is O(1) in the worst case.
+// Errors are reported through IoTDataStatus instead of the IoTDataException hierarchy.
+
+enum class IoTDataStatus {
+    OK,
+    EMPTY,              // No data points
+    INSUFFICIENT_DATA,  // Fewer points than the calculation needs
+    FULL,               // Capacity reached under StaticOverflowPolicy::REJECT
+    OUT_OF_ORDER,       // Timestamp older than the newest point
+    INVALID_ARGUMENT    // NaN/infinite input, zero window or undersized output buffer
+};
+
+enum class StaticOverflowPolicy {
+    OVERWRITE_OLDEST,
+    REJECT
+};
+
+template <size_t Capacity>
+class IoTDataStatic {
+    static_assert(Capacity > 0, "IoTDataStatic needs a non-zero capacity");
+
+private:
+    // Ring buffer of points in ascending timestamp order, oldest at head
+    double data[Capacity];
+    double timestamps[Capacity];
+    size_t head = 0;
+    size_t count = 0;
+    StaticOverflowPolicy overflowPolicy;
+
+    size_t slot(size_t index) const noexcept {
+        size_t position = head + index;
+        return position >= Capacity ? position - Capacity : position;
+    }
+
+    // First logical index whose timestamp is not less than t
+    size_t lowerBound(double t) const noexcept {
+        size_t first = 0;
+        size_t length = count;
+        while (length > 0) {
+            size_t half = length / 2;
+            if (timestamps[slot(first + half)] < t) {
+                first += half + 1;
+                length -= half + 1;
+            } else {
+                length = half;
+            }
+        }
+        return first;
+    }
+
+    double interpolateAt(double t) const noexcept {
+        size_t index = lowerBound(t);
+        if (index == 0) {
+            return data[slot(0)];
+        }
+        if (index == count) {
+            return data[slot(count - 1)];
+        }
+        double t0 = timestamps[slot(index - 1)];
+        double t1 = timestamps[slot(index)];
+        double y0 = data[slot(index - 1)];
+        double y1 = data[slot(index)];
+        return y0 + (y1 - y0) * (t - t0) / (t1 - t0);
+    }
+
+public:
+    explicit IoTDataStatic(StaticOverflowPolicy policy = StaticOverflowPolicy::OVERWRITE_OLDEST) noexcept
+        : overflowPolicy(policy) {}
+
+    // Basic data manipulation functions
+    IoTDataStatus appendData(double newData, double timestamp) noexcept {
+        if (!std::isfinite(newData) || !std::isfinite(timestamp)) {
+            return IoTDataStatus::INVALID_ARGUMENT;
+        }
+        if (count > 0 && timestamp < timestamps[slot(count - 1)]) {
+            return IoTDataStatus::OUT_OF_ORDER;
+        }
+
+        if (count == Capacity) {
+            if (overflowPolicy == StaticOverflowPolicy::REJECT) {
+                return IoTDataStatus::FULL;
+            }
+            head = slot(1);
+            --count;
+        }
+
+        size_t position = slot(count);
+        data[position] = newData;
+        timestamps[position] = timestamp;
+        ++count;
+        return IoTDataStatus::OK;
+    }
+
+    void clearData() noexcept {
+        head = 0;
+        count = 0;
+    }
+
+    size_t getDataSize() const noexcept { return count; }
+    static constexpr size_t getCapacity() noexcept { return Capacity; }
+    bool isFull() const noexcept { return count == Capacity; }
+
+    // Point access by age (0 is the oldest retained point); index must be below getDataSize()
+    double value(size_t index) const noexcept { return data[slot(index)]; }
+    double timestamp(size_t index) const noexcept { return timestamps[slot(index)]; }
+
+    // Statistical analysis functions
+    IoTDataStatus calculateMean(double& mean) const noexcept {
+        if (count == 0) {
+            return IoTDataStatus::EMPTY;
+        }
+        double sum = 0.0;
+        for (size_t i = 0; i < count; ++i) {
+            sum += data[slot(i)];
+        }
+        mean = sum / count;
+        return IoTDataStatus::OK;
+    }
+
+    // Population standard deviation, matching IoTData::calculateStandardDeviation
+    IoTDataStatus calculateStandardDeviation(double& deviation) const noexcept {
+        if (count < 2) {
+            return IoTDataStatus::INSUFFICIENT_DATA;
+        }
+        double mean = 0.0;
+        calculateMean(mean);
+        double sum = 0.0;
+        for (size_t i = 0; i < count; ++i) {
+            double difference = data[slot(i)] - mean;
+            sum += difference * difference;
+        }
+        deviation = std::sqrt(sum / count);
+        return IoTDataStatus::OK;
+    }
+
+    IoTDataStatus calculateMinMax(double& minimum, double& maximum) const noexcept {
+        if (count == 0) {
+            return IoTDataStatus::EMPTY;
+        }
+        minimum = maximum = data[slot(0)];
+        for (size_t i = 1; i < count; ++i) {
+            double value = data[slot(i)];
+            minimum = value < minimum ? value : minimum;
+            maximum = value > maximum ? value : maximum;
+        }
+        return IoTDataStatus::OK;
+    }
+
+    // Moving average of every point (same shape as IoTData::calculateMovingAverage);
+    // output must hold getDataSize() values
+    IoTDataStatus calculateMovingAverage(size_t windowSize, double* output, size_t outputCapacity) const noexcept {
+        if (count == 0) {
+            return IoTDataStatus::EMPTY;
+        }
+        if (windowSize == 0 || output == nullptr || outputCapacity < count) {
+            return IoTDataStatus::INVALID_ARGUMENT;
+        }
+
+        double sum = 0.0;
+        for (size_t i = 0; i < count; ++i) {
+            sum += data[slot(i)];
+            if (i >= windowSize) {
+                sum -= data[slot(i - windowSize)];
+                output[i] = sum / windowSize;
+            } else {
+                output[i] = sum / (i + 1);
+            }
+        }
+        return IoTDataStatus::OK;
+    }
+
+    // Mean of the newest windowSize points (or of all points while fewer are retained)
+    IoTDataStatus calculateRollingMean(size_t windowSize, double& mean) const noexcept {
+        if (count == 0) {
+            return IoTDataStatus::EMPTY;
+        }
+        if (windowSize == 0) {
+            return IoTDataStatus::INVALID_ARGUMENT;
+        }
+
+        size_t first = windowSize < count ? count - windowSize : 0;
+        double sum = 0.0;
+        for (size_t i = first; i < count; ++i) {
+            sum += data[slot(i)];
+        }
+        mean = sum / (count - first);
+        return IoTDataStatus::OK;
+    }
+
+    // Linear interpolation, clamped to the first/last value outside the retained time range
+    IoTDataStatus interpolateData(double newTimestamp, double& result) const noexcept {
+        if (count == 0) {
+            return IoTDataStatus::EMPTY;
+        }
+        result = interpolateAt(newTimestamp);
+        return IoTDataStatus::OK;
+    }
+
+    IoTDataStatus interpolateData(const double* newTimestamps, size_t timestampCount, double* output) const noexcept {
+        if (count == 0) {
+            return IoTDataStatus::EMPTY;
+        }
+        if (timestampCount > 0 && (newTimestamps == nullptr || output == nullptr)) {
+            return IoTDataStatus::INVALID_ARGUMENT;
+        }
+        for (size_t i = 0; i < timestampCount; ++i) {
+            output[i] = interpolateAt(newTimestamps[i]);
+        }
+        return IoTDataStatus::OK;
+    }
+};
+
+#endif // IOT_DATA_STATIC_H
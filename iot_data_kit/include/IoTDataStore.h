@@ -0,0 +1,45 @@
+// IoTDataStore.h
+#ifndef IOT_DATA_STORE_H
+#define IOT_DATA_STORE_H
+
+#include "IoTData.h"
+#include <map>
+#include <string>
+#include <vector>
+
+// Multi-series container keyed by series id (ordered, so iteration and snapshots are deterministic)
+class IoTDataStore {
+private:
+    std::map<std::string, IoTData> series;
+
+public:
+    // Series management
+    IoTData& addSeries(const std::string& seriesId);
+    IoTData& addSeries(const std::string& seriesId, IoTData seriesData);
+    void removeSeries(const std::string& seriesId);
+    bool hasSeries(const std::string& seriesId) const;
+    void clear();
+
+    // Series access
+    IoTData& getSeries(const std::string& seriesId);
+    const IoTData& getSeries(const std::string& seriesId) const;
+    std::vector<std::string> getSeriesIds() const;
+    size_t getSeriesCount() const;
+
+    // Ingest into a series, creating it on first use
+    void appendData(const std::string& seriesId, double newData, double timestamp);
+
+    // Per-sensor ingest calibration, creating the series on first use
+    void setCalibration(const std::string& seriesId, const IoTDataCalibration& calibration);
+
+    // Batch-normalize every non-empty series, spreading series across threads (0 = hardware concurrency)
+    void normalizeAll(NormalizationMethod method = NormalizationMethod::Z_SCORE, size_t threadCount = 0);
+
+    // Iteration in series id order
+    std::map<std::string, IoTData>::iterator begin() { return series.begin(); }
+    std::map<std::string, IoTData>::iterator end() { return series.end(); }
+    std::map<std::string, IoTData>::const_iterator begin() const { return series.begin(); }
+    std::map<std::string, IoTData>::const_iterator end() const { return series.end(); }
+};
+
+#endif // IOT_DATA_STORE_H
@@ -0,0 +1,29 @@
+// IoTDataView.h
+#ifndef IOT_DATA_VIEW_H
+#define IOT_DATA_VIEW_H
+
+#include <cstddef>
+
+// Non-owning, read-only view of a series' value and timestamp columns.
+// The view is invalidated by any operation that reallocates the underlying storage.
+class IoTDataView {
+private:
+    const double* valueColumn = nullptr;
+    const double* timestampColumn = nullptr;
+    size_t rowCount = 0;
+
+public:
+    IoTDataView() = default;
+    IoTDataView(const double* values, const double* timestamps, size_t size)
+        : valueColumn(values), timestampColumn(timestamps), rowCount(size) {}
+
+    const double* values() const { return valueColumn; }
+    const double* timestamps() const { return timestampColumn; }
+    size_t size() const { return rowCount; }
+    bool empty() const { return rowCount == 0; }
+
+    double value(size_t index) const { return valueColumn[index]; }
+    double timestamp(size_t index) const { return timestampColumn[index]; }
+};
+
+#endif // IOT_DATA_VIEW_H
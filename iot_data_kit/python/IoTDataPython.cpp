@@ -0,0 +1,607 @@
+// IoTDataPython.cpp
+// CPython extension module "iotdatakit". Columns and kernel results are exported through the
+// buffer protocol, so numpy.asarray() wraps them without copying:
+//
+//     series = iotdatakit.IoTData(values, timestamps)
+//     averages = numpy.asarray(series.calculateMovingAverage(16))
+//     values = numpy.asarray(series.values)   # read-only view of the series' own storage
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include "IoTData.h"
+#include "IoTDataException.h"
+#include <exception>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+PyObject* ioTDataError = nullptr;
+PyObject* ioTDataEmptyError = nullptr;
+PyObject* ioTDataInsufficientError = nullptr;
+PyObject* ioTDataFileError = nullptr;
+
+// Translate a C++ exception into the matching Python exception; must be called with the GIL held
+void setPythonError(std::exception_ptr error) {
+    try {
+        std::rethrow_exception(error);
+    } catch (const IoTDataEmptyException& e) {
+        PyErr_SetString(ioTDataEmptyError, e.what());
+    } catch (const IoTDataInsufficientException& e) {
+        PyErr_SetString(ioTDataInsufficientError, e.what());
+    } catch (const IoTDataFileException& e) {
+        PyErr_SetString(ioTDataFileError, e.what());
+    } catch (const IoTDataException& e) {
+        PyErr_SetString(ioTDataError, e.what());
+    } catch (const std::bad_alloc&) {
+        PyErr_NoMemory();
+    } catch (const std::exception& e) {
+        PyErr_SetString(PyExc_RuntimeError, e.what());
+    }
+}
+
+struct SeriesObject {
+    PyObject_HEAD
+    IoTData* series;
+    Py_ssize_t exports;   // Buffers currently exported from the series' columns
+    Py_ssize_t readers;   // Read-only kernels running on the series with the GIL released
+    bool writing;         // A mutating kernel is running on the series with the GIL released
+};
+
+enum class ColumnSource {
+    OWNED,
+    SERIES_VALUES,
+    SERIES_TIMESTAMPS
+};
+
+// Buffer exporter: either owns a kernel result or refers to one column of a series
+struct ColumnObject {
+    PyObject_HEAD
+    ColumnSource source;
+    std::vector<double>* owned;
+    SeriesObject* owner;
+    Py_ssize_t shape;
+};
+
+PyTypeObject SeriesType = {PyVarObject_HEAD_INIT(nullptr, 0) "iotdatakit.IoTData"};
+PyTypeObject ColumnType = {PyVarObject_HEAD_INIT(nullptr, 0) "iotdatakit.Column"};
+
+// Series mutations that may reallocate the columns are refused while buffers are exported,
+// and every mutation is refused while another kernel runs without the GIL
+bool checkMutable(SeriesObject* self, bool reallocates) {
+    if (self->writing || self->readers > 0 || (reallocates && self->exports > 0)) {
+        PyErr_SetString(PyExc_BufferError,
+                        "Error: Series is in use by an exported buffer or a running computation.");
+        return false;
+    }
+    return true;
+}
+
+// Reads (kernels, buffer exports, len) are refused while a mutation runs without the GIL, since the
+// columns may be compacted or reallocated under them
+bool checkReadable(SeriesObject* self) {
+    if (self->writing) {
+        PyErr_SetString(PyExc_BufferError, "Error: Series is being modified by a running computation.");
+        return false;
+    }
+    return true;
+}
+
+// Run a kernel with the GIL released; callers mark the series as read or written first
+template <typename Kernel>
+bool runWithoutGil(Kernel&& kernel) {
+    std::exception_ptr error;
+    Py_BEGIN_ALLOW_THREADS
+    try {
+        kernel();
+    } catch (...) {
+        error = std::current_exception();
+    }
+    Py_END_ALLOW_THREADS
+
+    if (error) {
+        setPythonError(error);
+        return false;
+    }
+    return true;
+}
+
+// Accepts any contiguous float64 buffer (e.g. a NumPy array) or a sequence of numbers
+bool toVector(PyObject* object, std::vector<double>& result) {
+    Py_buffer buffer;
+    if (PyObject_GetBuffer(object, &buffer, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) == 0) {
+        bool isDouble = buffer.itemsize == sizeof(double) && buffer.format != nullptr &&
+                        (std::string(buffer.format) == "d" || std::string(buffer.format) == "<d" ||
+                         std::string(buffer.format) == "=d" || std::string(buffer.format) == "@d");
+        if (isDouble) {
+            const double* begin = static_cast<const double*>(buffer.buf);
+            result.assign(begin, begin + buffer.len / static_cast<Py_ssize_t>(sizeof(double)));
+        }
+        PyBuffer_Release(&buffer);
+        if (isDouble) {
+            return true;
+        }
+    } else {
+        PyErr_Clear();
+    }
+
+    PyObject* sequence = PySequence_Fast(object, "Error: Expected a sequence of numbers.");
+    if (sequence == nullptr) {
+        return false;
+    }
+    Py_ssize_t size = PySequence_Fast_GET_SIZE(sequence);
+    PyObject** items = PySequence_Fast_ITEMS(sequence);
+    result.resize(static_cast<size_t>(size));
+    for (Py_ssize_t i = 0; i < size; ++i) {
+        result[i] = PyFloat_AsDouble(items[i]);
+        if (result[i] == -1.0 && PyErr_Occurred()) {
+            Py_DECREF(sequence);
+            return false;
+        }
+    }
+    Py_DECREF(sequence);
+    return true;
+}
+
+PyObject* newOwnedColumn(std::vector<double>&& values) {
+    ColumnObject* column = PyObject_New(ColumnObject, &ColumnType);
+    if (column == nullptr) {
+        return nullptr;
+    }
+    column->source = ColumnSource::OWNED;
+    column->owner = nullptr;
+    column->owned = new (std::nothrow) std::vector<double>(std::move(values));
+    if (column->owned == nullptr) {
+        Py_DECREF(column);
+        return PyErr_NoMemory();
+    }
+    return reinterpret_cast<PyObject*>(column);
+}
+
+PyObject* newSeriesColumn(SeriesObject* owner, ColumnSource source) {
+    ColumnObject* column = PyObject_New(ColumnObject, &ColumnType);
+    if (column == nullptr) {
+        return nullptr;
+    }
+    column->source = source;
+    column->owned = nullptr;
+    Py_INCREF(owner);
+    column->owner = owner;
+    return reinterpret_cast<PyObject*>(column);
+}
+
+// Column
+
+void columnDealloc(ColumnObject* self) {
+    delete self->owned;
+    Py_XDECREF(self->owner);
+    PyObject_Free(self);
+}
+
+int columnGetBuffer(ColumnObject* self, Py_buffer* view, int flags) {
+    const double* data;
+    size_t size;
+    bool readOnly = self->source != ColumnSource::OWNED;
+    if (self->source == ColumnSource::OWNED) {
+        data = self->owned->data();
+        size = self->owned->size();
+    } else {
+        // Resolved on every request since the series may have grown since the column was created
+        if (!checkReadable(self->owner)) {
+            view->obj = nullptr;
+            return -1;
+        }
+        IoTDataView columns = self->owner->series->view();
+        data = self->source == ColumnSource::SERIES_VALUES ? columns.values() : columns.timestamps();
+        size = columns.size();
+    }
+
+    if (readOnly && (flags & PyBUF_WRITABLE) == PyBUF_WRITABLE) {
+        PyErr_SetString(PyExc_BufferError, "Error: Series columns are read-only.");
+        view->obj = nullptr;
+        return -1;
+    }
+
+    self->shape = static_cast<Py_ssize_t>(size);
+    view->obj = reinterpret_cast<PyObject*>(self);
+    view->buf = const_cast<double*>(data);
+    view->len = self->shape * static_cast<Py_ssize_t>(sizeof(double));
+    view->readonly = readOnly ? 1 : 0;
+    view->itemsize = sizeof(double);
+    view->format = (flags & PyBUF_FORMAT) ? const_cast<char*>("d") : nullptr;
+    view->ndim = 1;
+    view->shape = (flags & PyBUF_ND) ? &self->shape : nullptr;
+    view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? &view->itemsize : nullptr;
+    view->suboffsets = nullptr;
+    view->internal = nullptr;
+    Py_INCREF(self);
+
+    if (self->owner != nullptr) {
+        ++self->owner->exports;
+    }
+    return 0;
+}
+
+void columnReleaseBuffer(ColumnObject* self, Py_buffer*) {
+    if (self->owner != nullptr) {
+        --self->owner->exports;
+    }
+}
+
+Py_ssize_t columnLength(ColumnObject* self) {
+    if (self->source == ColumnSource::OWNED) {
+        return static_cast<Py_ssize_t>(self->owned->size());
+    }
+    if (!checkReadable(self->owner)) {
+        return -1;
+    }
+    return static_cast<Py_ssize_t>(self->owner->series->getDataSize());
+}
+
+PyBufferProcs columnBufferProcs = {
+    reinterpret_cast<getbufferproc>(columnGetBuffer),
+    reinterpret_cast<releasebufferproc>(columnReleaseBuffer),
+};
+
+PySequenceMethods columnSequenceMethods = {
+    reinterpret_cast<lenfunc>(columnLength),
+};
+
+// Series
+
+PyObject* seriesNew(PyTypeObject* type, PyObject*, PyObject*) {
+    SeriesObject* self = reinterpret_cast<SeriesObject*>(type->tp_alloc(type, 0));
+    if (self != nullptr) {
+        self->series = nullptr;
+        self->exports = 0;
+        self->readers = 0;
+        self->writing = false;
+    }
+    return reinterpret_cast<PyObject*>(self);
+}
+
+int seriesInit(SeriesObject* self, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"values", "timestamps", nullptr};
+    PyObject* valueObject = nullptr;
+    PyObject* timestampObject = nullptr;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|OO", const_cast<char**>(keywords), &valueObject,
+                                     &timestampObject)) {
+        return -1;
+    }
+    if (self->series != nullptr && !checkMutable(self, true)) {
+        return -1;
+    }
+
+    std::vector<double> values;
+    std::vector<double> timestamps;
+    if ((valueObject != nullptr && !toVector(valueObject, values)) ||
+        (timestampObject != nullptr && !toVector(timestampObject, timestamps))) {
+        return -1;
+    }
+
+    try {
+        IoTData* series = timestampObject != nullptr ? new IoTData(values, timestamps) : new IoTData(values);
+        delete self->series;
+        self->series = series;
+    } catch (...) {
+        setPythonError(std::current_exception());
+        return -1;
+    }
+    return 0;
+}
+
+void seriesDealloc(SeriesObject* self) {
+    delete self->series;
+    Py_TYPE(self)->tp_free(reinterpret_cast<PyObject*>(self));
+}
+
+bool checkInitialized(SeriesObject* self) {
+    if (self->series == nullptr) {
+        PyErr_SetString(ioTDataError, "Error: IoTData object is not initialized.");
+        return false;
+    }
+    return true;
+}
+
+Py_ssize_t seriesLength(SeriesObject* self) {
+    if (!checkReadable(self)) {
+        return -1;
+    }
+    return self->series == nullptr ? 0 : static_cast<Py_ssize_t>(self->series->getDataSize());
+}
+
+PyObject* seriesValues(SeriesObject* self, void*) {
+    if (!checkInitialized(self) || !checkReadable(self)) {
+        return nullptr;
+    }
+    return newSeriesColumn(self, ColumnSource::SERIES_VALUES);
+}
+
+PyObject* seriesTimestamps(SeriesObject* self, void*) {
+    if (!checkInitialized(self) || !checkReadable(self)) {
+        return nullptr;
+    }
+    return newSeriesColumn(self, ColumnSource::SERIES_TIMESTAMPS);
+}
+
+PyObject* seriesAppendData(SeriesObject* self, PyObject* args) {
+    double value;
+    double timestamp;
+    if (!PyArg_ParseTuple(args, "dd", &value, &timestamp) || !checkInitialized(self) || !checkMutable(self, true)) {
+        return nullptr;
+    }
+    try {
+        self->series->appendData(value, timestamp);
+    } catch (...) {
+        setPythonError(std::current_exception());
+        return nullptr;
+    }
+    Py_RETURN_NONE;
+}
+
+PyObject* seriesClearData(SeriesObject* self, PyObject*) {
+    if (!checkInitialized(self) || !checkMutable(self, true)) {
+        return nullptr;
+    }
+    self->series->clearData();
+    Py_RETURN_NONE;
+}
+
+// Mutating kernel run without the GIL
+template <typename Kernel>
+PyObject* mutateSeries(SeriesObject* self, bool reallocates, Kernel&& kernel) {
+    if (!checkInitialized(self) || !checkMutable(self, reallocates)) {
+        return nullptr;
+    }
+    self->writing = true;
+    bool done = runWithoutGil([&] { kernel(*self->series); });
+    self->writing = false;
+    if (!done) {
+        return nullptr;
+    }
+    Py_RETURN_NONE;
+}
+
+// Read-only kernel run without the GIL; concurrent readers are allowed, writers are not
+template <typename Result, typename Kernel>
+bool computeSeries(SeriesObject* self, Result& result, Kernel&& kernel) {
+    if (!checkInitialized(self) || !checkReadable(self)) {
+        return false;
+    }
+    const IoTData& series = *self->series;
+    ++self->readers;
+    bool done = runWithoutGil([&] { result = kernel(series); });
+    --self->readers;
+    return done;
+}
+
+PyObject* seriesFilterOutliers(SeriesObject* self, PyObject* args) {
+    double threshold;
+    if (!PyArg_ParseTuple(args, "d", &threshold)) {
+        return nullptr;
+    }
+    return mutateSeries(self, true, [threshold](IoTData& series) { series.filterOutliers(threshold); });
+}
+
+PyObject* seriesTrimData(SeriesObject* self, PyObject* args) {
+    double percentage;
+    if (!PyArg_ParseTuple(args, "d", &percentage)) {
+        return nullptr;
+    }
+    return mutateSeries(self, true, [percentage](IoTData& series) { series.trimData(percentage); });
+}
+
+PyObject* seriesSortByTimestamp(SeriesObject* self, PyObject*) {
+    return mutateSeries(self, true, [](IoTData& series) { series.sortByTimestamp(); });
+}
+
+PyObject* seriesScaleData(SeriesObject* self, PyObject* args) {
+    double factor;
+    if (!PyArg_ParseTuple(args, "d", &factor)) {
+        return nullptr;
+    }
+    return mutateSeries(self, false, [factor](IoTData& series) { series.scaleData(factor); });
+}
+
+PyObject* seriesNormalizeData(SeriesObject* self, PyObject*) {
+    return mutateSeries(self, false, [](IoTData& series) { series.normalizeData(); });
+}
+
+PyObject* seriesImportDataFromFile(SeriesObject* self, PyObject* args) {
+    const char* filename;
+    if (!PyArg_ParseTuple(args, "s", &filename)) {
+        return nullptr;
+    }
+    std::string path(filename);
+    return mutateSeries(self, true, [&path](IoTData& series) { series.importDataFromFile(path); });
+}
+
+PyObject* seriesExportDataToFile(SeriesObject* self, PyObject* args) {
+    const char* filename;
+    if (!PyArg_ParseTuple(args, "s", &filename)) {
+        return nullptr;
+    }
+    std::string path(filename);
+    bool done = false;
+    if (!computeSeries(self, done, [&path](const IoTData& series) {
+            series.exportDataToFile(path);
+            return true;
+        })) {
+        return nullptr;
+    }
+    Py_RETURN_NONE;
+}
+
+PyObject* seriesCalculateMean(SeriesObject* self, PyObject*) {
+    double mean = 0.0;
+    if (!computeSeries(self, mean, [](const IoTData& series) { return series.calculateMean(); })) {
+        return nullptr;
+    }
+    return PyFloat_FromDouble(mean);
+}
+
+PyObject* seriesCalculateStandardDeviation(SeriesObject* self, PyObject*) {
+    double deviation = 0.0;
+    if (!computeSeries(self, deviation, [](const IoTData& series) { return series.calculateStandardDeviation(); })) {
+        return nullptr;
+    }
+    return PyFloat_FromDouble(deviation);
+}
+
+// Kernels returning a new column hand their result vector to a Column object without copying
+template <typename Kernel>
+PyObject* columnResult(SeriesObject* self, Kernel&& kernel) {
+    std::vector<double> result;
+    if (!computeSeries(self, result, std::forward<Kernel>(kernel))) {
+        return nullptr;
+    }
+    return newOwnedColumn(std::move(result));
+}
+
+PyObject* seriesCalculateMovingAverage(SeriesObject* self, PyObject* args) {
+    Py_ssize_t windowSize;
+    if (!PyArg_ParseTuple(args, "n", &windowSize)) {
+        return nullptr;
+    }
+    size_t window = static_cast<size_t>(windowSize);
+    return columnResult(self, [window](const IoTData& series) { return series.calculateMovingAverage(window); });
+}
+
+PyObject* seriesCalculateRollingMean(SeriesObject* self, PyObject* args) {
+    Py_ssize_t windowSize;
+    if (!PyArg_ParseTuple(args, "n", &windowSize)) {
+        return nullptr;
+    }
+    size_t window = static_cast<size_t>(windowSize);
+    return columnResult(self, [window](const IoTData& series) { return series.calculateRollingMean(window); });
+}
+
+PyObject* seriesResampleData(SeriesObject* self, PyObject* args) {
+    Py_ssize_t targetSize;
+    if (!PyArg_ParseTuple(args, "n", &targetSize)) {
+        return nullptr;
+    }
+    size_t target = static_cast<size_t>(targetSize);
+    return columnResult(self, [target](const IoTData& series) { return series.resampleData(target); });
+}
+
+PyObject* seriesInterpolateData(SeriesObject* self, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"newTimestamps", "method", nullptr};
+    PyObject* timestampObject;
+    int method = static_cast<int>(InterpolationMethod::LINEAR);
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|i", const_cast<char**>(keywords), &timestampObject, &method)) {
+        return nullptr;
+    }
+    if (method < static_cast<int>(InterpolationMethod::LINEAR) ||
+        method > static_cast<int>(InterpolationMethod::CUBIC_SPLINE)) {
+        PyErr_SetString(PyExc_ValueError, "Error: Unknown interpolation method.");
+        return nullptr;
+    }
+
+    std::vector<double> newTimestamps;
+    if (!toVector(timestampObject, newTimestamps)) {
+        return nullptr;
+    }
+    InterpolationMethod interpolation = static_cast<InterpolationMethod>(method);
+    return columnResult(self, [&newTimestamps, interpolation](const IoTData& series) {
+        return series.interpolateData(newTimestamps, interpolation);
+    });
+}
+
+PyMethodDef seriesMethods[] = {
+    {"appendData", reinterpret_cast<PyCFunction>(seriesAppendData), METH_VARARGS, "Append a (value, timestamp) point."},
+    {"clearData", reinterpret_cast<PyCFunction>(seriesClearData), METH_NOARGS, "Remove all points."},
+    {"filterOutliers", reinterpret_cast<PyCFunction>(seriesFilterOutliers), METH_VARARGS,
+     "Drop points whose absolute value exceeds threshold (NaN values are kept)."},
+    {"trimData", reinterpret_cast<PyCFunction>(seriesTrimData), METH_VARARGS, "Drop percentage / 2 percent of the points from each end of the series."},
+    {"sortByTimestamp", reinterpret_cast<PyCFunction>(seriesSortByTimestamp), METH_NOARGS, "Sort points by timestamp."},
+    {"scaleData", reinterpret_cast<PyCFunction>(seriesScaleData), METH_VARARGS, "Multiply all values by a factor."},
+    {"normalizeData", reinterpret_cast<PyCFunction>(seriesNormalizeData), METH_NOARGS, "Normalize values to zero mean and unit standard deviation (z-score)."},
+    {"importDataFromFile", reinterpret_cast<PyCFunction>(seriesImportDataFromFile), METH_VARARGS,
+     "Replace the series with the points of a CSV, binary or gzip-compressed file."},
+    {"exportDataToFile", reinterpret_cast<PyCFunction>(seriesExportDataToFile), METH_VARARGS,
+     "Write the series as CSV (gzip-compressed for .gz names, binary for .bin.gz)."},
+    {"calculateMean", reinterpret_cast<PyCFunction>(seriesCalculateMean), METH_NOARGS, "Mean of the values."},
+    {"calculateStandardDeviation", reinterpret_cast<PyCFunction>(seriesCalculateStandardDeviation), METH_NOARGS,
+     "Standard deviation of the values."},
+    {"calculateMovingAverage", reinterpret_cast<PyCFunction>(seriesCalculateMovingAverage), METH_VARARGS,
+     "Moving average as a buffer-protocol column."},
+    {"calculateRollingMean", reinterpret_cast<PyCFunction>(seriesCalculateRollingMean), METH_VARARGS,
+     "Rolling mean as a buffer-protocol column."},
+    {"resampleData", reinterpret_cast<PyCFunction>(seriesResampleData), METH_VARARGS,
+     "Resampled values as a buffer-protocol column."},
+    {"interpolateData", reinterpret_cast<PyCFunction>(seriesInterpolateData), METH_VARARGS | METH_KEYWORDS,
+     "Values interpolated at newTimestamps as a buffer-protocol column."},
+    {nullptr, nullptr, 0, nullptr}
+};
+
+PyGetSetDef seriesGetSet[] = {
+    {"values", reinterpret_cast<getter>(seriesValues), nullptr, "Read-only buffer over the value column.", nullptr},
+    {"timestamps", reinterpret_cast<getter>(seriesTimestamps), nullptr, "Read-only buffer over the timestamp column.",
+     nullptr},
+    {nullptr, nullptr, nullptr, nullptr, nullptr}
+};
+
+PySequenceMethods seriesSequenceMethods = {
+    reinterpret_cast<lenfunc>(seriesLength),
+};
+
+PyModuleDef moduleDefinition = {
+    PyModuleDef_HEAD_INIT, "iotdatakit", "Python bindings for IoTDataKit.", -1, nullptr, nullptr, nullptr, nullptr,
+    nullptr
+};
+
+bool addException(PyObject* module, PyObject*& exception, const char* name, PyObject* base) {
+    std::string qualifiedName = std::string("iotdatakit.") + name;
+    exception = PyErr_NewException(qualifiedName.c_str(), base, nullptr);
+    return exception != nullptr && PyModule_AddObjectRef(module, name, exception) == 0;
+}
+
+} // namespace
+
+PyMODINIT_FUNC PyInit_iotdatakit() {
+    ColumnType.tp_basicsize = sizeof(ColumnObject);
+    ColumnType.tp_flags = Py_TPFLAGS_DEFAULT;
+    ColumnType.tp_doc = "Float64 column exported through the buffer protocol (use numpy.asarray).";
+    ColumnType.tp_dealloc = reinterpret_cast<destructor>(columnDealloc);
+    ColumnType.tp_as_buffer = &columnBufferProcs;
+    ColumnType.tp_as_sequence = &columnSequenceMethods;
+
+    SeriesType.tp_basicsize = sizeof(SeriesObject);
+    SeriesType.tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE;
+    SeriesType.tp_doc = "IoTData(values=(), timestamps=None)";
+    SeriesType.tp_new = seriesNew;
+    SeriesType.tp_init = reinterpret_cast<initproc>(seriesInit);
+    SeriesType.tp_dealloc = reinterpret_cast<destructor>(seriesDealloc);
+    SeriesType.tp_methods = seriesMethods;
+    SeriesType.tp_getset = seriesGetSet;
+    SeriesType.tp_as_sequence = &seriesSequenceMethods;
+
+    if (PyType_Ready(&ColumnType) < 0 || PyType_Ready(&SeriesType) < 0) {
+        return nullptr;
+    }
+
+    PyObject* module = PyModule_Create(&moduleDefinition);
+    if (module == nullptr) {
+        return nullptr;
+    }
+
+    bool ready = PyModule_AddObjectRef(module, "IoTData", reinterpret_cast<PyObject*>(&SeriesType)) == 0 &&
+                 PyModule_AddObjectRef(module, "Column", reinterpret_cast<PyObject*>(&ColumnType)) == 0 &&
+                 addException(module, ioTDataError, "IoTDataError", PyExc_RuntimeError) &&
+                 addException(module, ioTDataEmptyError, "IoTDataEmptyError", ioTDataError) &&
+                 addException(module, ioTDataInsufficientError, "IoTDataInsufficientError", ioTDataError) &&
+                 addException(module, ioTDataFileError, "IoTDataFileError", ioTDataError) &&
+                 PyModule_AddIntConstant(module, "LINEAR", static_cast<int>(InterpolationMethod::LINEAR)) == 0 &&
+                 PyModule_AddIntConstant(module, "NEAREST_NEIGHBOR",
+                                         static_cast<int>(InterpolationMethod::NEAREST_NEIGHBOR)) == 0 &&
+                 PyModule_AddIntConstant(module, "CUBIC_SPLINE",
+                                         static_cast<int>(InterpolationMethod::CUBIC_SPLINE)) == 0;
+    if (!ready) {
+        Py_DECREF(module);
+        return nullptr;
+    }
+    return module;
+}
@@ -1,15 +1,171 @@
 // IoTData.cpp
 #include "IoTData.h"
+#include "IoTDataAggregate.h"
+#include "IoTDataBits.h"
 #include "IoTDataException.h"
+#include "IoTDataCalibration.h"
+#include "IoTDataPlot.h"
+#include "IoTDataPredicate.h"
+#include "IoTDataSort.h"
+#include "IoTDataSimd.h"
+#include "IoTDataBinaryFormat.h"
+#include "IoTDataGzip.h"
 #include <iostream>
 #include <fstream>
 #include <algorithm>
+#include <atomic>
 #include <numeric>
 #include <cmath>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+
+namespace {
+
+std::atomic<SummationMethod> defaultSummationMethod{SummationMethod::FAST};
+
+constexpr size_t kSummaryBlockSize = IoTData::kSummaryBlockSize;
+
+// Whether [begin, begin + count) overlaps the column (std::less orders pointers into unrelated arrays)
+bool overlapsColumn(const double* begin, size_t count, const std::vector<double>& column) {
+    std::less<const double*> before;
+    return count > 0 && !column.empty() && before(begin, column.data() + column.size()) &&
+           before(column.data(), begin + count);
+}
+
+IoTDataBlockSummary emptySummary() {
+    return {std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(), false};
+}
+
+void widenSummary(IoTDataBlockSummary& summary, double value) {
+    if (std::isnan(value)) {
+        summary.hasNan = true;
+        return;
+    }
+    summary.minimum = value < summary.minimum ? value : summary.minimum;
+    summary.maximum = value > summary.maximum ? value : summary.maximum;
+}
+
+IoTDataBlockSummary summarizeBlock(const double* values, size_t count) {
+    IoTDataBlockSummary summary = emptySummary();
+    if (IoTDataSimd::minMax(values, count, summary.minimum, summary.maximum)) {
+        return summary;
+    }
+    summary = emptySummary();
+    for (size_t i = 0; i < count; ++i) {
+        widenSummary(summary, values[i]);
+    }
+    return summary;
+}
+
+// Summary of values mapped through a non-decreasing function (rounding keeps the extremes in place)
+template <typename F>
+void mapSummaries(std::vector<IoTDataBlockSummary>& summaries, F f) {
+    for (IoTDataBlockSummary& summary : summaries) {
+        summary.minimum = f(summary.minimum);
+        summary.maximum = f(summary.maximum);
+    }
+}
+
+// Quantile by linear interpolation between order statistics; reorders values
+double selectQuantile(std::vector<double>& values, double quantile) {
+    double position = (values.size() - 1) * quantile;
+    size_t lower = static_cast<size_t>(position);
+    std::nth_element(values.begin(), values.begin() + lower, values.end());
+    double lowerValue = values[lower];
+    if (lower + 1 == values.size()) {
+        return lowerValue;
+    }
+    double upperValue = *std::min_element(values.begin() + lower + 1, values.end());
+    return lowerValue + (position - lower) * (upperValue - lowerValue);
+}
+
+} // namespace
+
+IoTData::AppendListeners::AppendListeners(const AppendListeners&) {}
+
+IoTData::AppendListeners& IoTData::AppendListeners::operator=(const AppendListeners&) {
+    return *this;
+}
+
+size_t IoTData::AppendListeners::add(AppendListener listener) {
+    (notifyDepth > 0 ? added : entries).emplace_back(nextId, std::move(listener));
+    return nextId++;
+}
+
+void IoTData::AppendListeners::remove(size_t listenerId) {
+    auto matches = [listenerId](const std::pair<size_t, AppendListener>& entry) { return entry.first == listenerId; };
+    added.erase(std::remove_if(added.begin(), added.end(), matches), added.end());
+    if (notifyDepth == 0) {
+        entries.erase(std::remove_if(entries.begin(), entries.end(), matches), entries.end());
+        return;
+    }
+
+    // The listener may be the one running, so its function is kept alive until the entries are compacted
+    auto it = std::find_if(entries.begin(), entries.end(), matches);
+    if (it != entries.end()) {
+        it->first = kRemovedListener;
+        removedWhileNotifying = true;
+    }
+}
+
+void IoTData::AppendListeners::notify(double value, double timestamp) {
+    struct DepthGuard {
+        AppendListeners& listeners;
+        ~DepthGuard() {
+            if (--listeners.notifyDepth > 0) {
+                return;
+            }
+            if (listeners.removedWhileNotifying) {
+                listeners.entries.erase(
+                    std::remove_if(listeners.entries.begin(), listeners.entries.end(),
+                                   [](const std::pair<size_t, AppendListener>& entry) {
+                                       return entry.first == kRemovedListener;
+                                   }),
+                    listeners.entries.end());
+                listeners.removedWhileNotifying = false;
+            }
+            std::move(listeners.added.begin(), listeners.added.end(), std::back_inserter(listeners.entries));
+            listeners.added.clear();
+        }
+    };
+
+    ++notifyDepth;
+    DepthGuard guard{*this};
+    for (const auto& listener : entries) {
+        if (listener.first != kRemovedListener) {
+            listener.second(value, timestamp);
+        }
+    }
+}
+
+IoTData::SplineCache::SplineCache(const SplineCache& other) {
+    *this = other;
+}
+
+IoTData::SplineCache& IoTData::SplineCache::operator=(const SplineCache& other) {
+    if (this != &other) {
+        std::lock_guard<std::mutex> lock(other.mutex);
+        valid = other.valid;
+        coefficients = other.coefficients;
+    }
+    return *this;
+}
+
+void IoTData::SplineCache::invalidate() {
+    valid = false;
+}
+
+std::vector<double> IoTData::SplineCache::copy() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return valid ? coefficients : std::vector<double>();
+}
 
 IoTData::IoTData(const std::vector<double>& initialData) : data(initialData) {
     timestamps.resize(initialData.size());
     std::iota(timestamps.begin(), timestamps.end(), 0.0);
+    summarizeBlocks(0);
 }
 
 IoTData::IoTData(const std::vector<double>& initialData, const std::vector<double>& initialTimestamps) 
@@ -17,131 +173,679 @@ IoTData::IoTData(const std::vector<double>& initialData, const std::vector<doubl
     if (data.size() != timestamps.size()) {
         throw IoTDataException("Error: Number of data points and timestamps must match.");
     }
+    summarizeBlocks(0);
 }
 
 void IoTData::appendData(double newData, double timestamp) {
+    // In-order appends cost a single comparison; only late or repeated timestamps are looked up
+    splineCache.invalidate();
+    if (calibration) {
+        newData = calibration->apply(newData);
+    }
+
+    if (duplicatePolicy != DuplicatePolicy::KEEP_ALL && !timestamps.empty() && timestamp <= timestamps.back() &&
+        mergeRecentDuplicate(newData, timestamp)) {
+        return;
+    }
+
     data.push_back(newData);
     timestamps.push_back(timestamp);
+    includeInBlockSummary(data.size() - 1);
+
+    if (!appendListeners.entries.empty()) {
+        appendListeners.notify(newData, timestamp);
+    }
+}
+
+void IoTData::appendData(const double* newData, const double* newTimestamps, size_t count) {
+    // Points taken from this series (e.g. through its view) would dangle once the columns grow
+    if (overlapsColumn(newData, count, data) || overlapsColumn(newData, count, timestamps) ||
+        overlapsColumn(newTimestamps, count, data) || overlapsColumn(newTimestamps, count, timestamps)) {
+        std::vector<double> values(newData, newData + count);
+        std::vector<double> times(newTimestamps, newTimestamps + count);
+        appendData(values.data(), times.data(), count);
+        return;
+    }
+
+    if (duplicatePolicy != DuplicatePolicy::KEEP_ALL) {
+        for (size_t i = 0; i < count; ++i) {
+            appendData(newData[i], newTimestamps[i]);
+        }
+        return;
+    }
+
+    // Without duplicate merging the batch is calibrated straight into the value column
+    splineCache.invalidate();
+    size_t offset = data.size();
+    data.resize(offset + count);
+    if (calibration) {
+        calibration->apply(newData, data.data() + offset, count);
+    } else {
+        std::copy(newData, newData + count, data.begin() + offset);
+    }
+    timestamps.insert(timestamps.end(), newTimestamps, newTimestamps + count);
+    summarizeBlocks(offset);
+
+    // Listeners may append to this series themselves; only the batch is announced here
+    size_t end = data.size();
+    for (size_t i = offset; i < end && !appendListeners.entries.empty(); ++i) {
+        appendListeners.notify(data[i], timestamps[i]);
+    }
 }
 
 void IoTData::clearData() {
     data.clear();
     timestamps.clear();
+    invalidateIndexes();
 }
 
 size_t IoTData::getDataSize() const {
     return data.size();
 }
 
+void IoTData::setDuplicatePolicy(DuplicatePolicy policy) {
+    duplicatePolicy = policy;
+    recentDuplicateCounts.clear();
+}
+
+DuplicatePolicy IoTData::getDuplicatePolicy() const {
+    return duplicatePolicy;
+}
+
+bool IoTData::mergeRecentDuplicate(double newData, double timestamp) {
+    size_t size = timestamps.size();
+    size_t stop = size > kRecentDuplicateWindow ? size - kRecentDuplicateWindow : 0;
+
+    size_t index = size;
+    for (size_t i = size; i-- > stop && timestamps[i] >= timestamp;) {
+        if (timestamps[i] == timestamp) {
+            index = i;
+            break;
+        }
+    }
+
+    if (index == size) {
+        return false;
+    }
+
+    switch (duplicatePolicy) {
+        case DuplicatePolicy::KEEP_ALL:
+        case DuplicatePolicy::KEEP_FIRST:
+            break;
+        case DuplicatePolicy::KEEP_LAST:
+            data[index] = newData;
+            break;
+        case DuplicatePolicy::MAX:
+            data[index] = std::max(data[index], newData);
+            break;
+        case DuplicatePolicy::AVERAGE: {
+            // Merge counts are only kept for points still inside the recent window
+            recentDuplicateCounts.erase(
+                std::remove_if(recentDuplicateCounts.begin(), recentDuplicateCounts.end(),
+                               [stop](const std::pair<size_t, size_t>& entry) { return entry.first < stop; }),
+                recentDuplicateCounts.end());
+
+            auto it = std::find_if(recentDuplicateCounts.begin(), recentDuplicateCounts.end(),
+                                   [index](const std::pair<size_t, size_t>& entry) { return entry.first == index; });
+            if (it == recentDuplicateCounts.end()) {
+                recentDuplicateCounts.emplace_back(index, 1);
+                it = recentDuplicateCounts.end() - 1;
+            }
+            ++it->second;
+            data[index] += (newData - data[index]) / it->second;
+            break;
+        }
+    }
+
+    includeInBlockSummary(index);
+    return true;
+}
+
+void IoTData::resolveDuplicateTimestamps(DuplicatePolicy policy) {
+    if (policy == DuplicatePolicy::KEEP_ALL || data.empty()) {
+        return;
+    }
+
+    // Runs of equal timestamps are adjacent once the series is sorted. The sort is stable, so KEEP_FIRST and
+    // KEEP_LAST still refer to insertion order, and costs one pass when the series is already sorted.
+    sortByTimestamp();
+    size_t out = 0;
+    for (size_t i = 0; i < data.size();) {
+        size_t end = i + 1;
+        double sum = data[i];
+        double maxValue = data[i];
+        while (end < data.size() && timestamps[end] == timestamps[i]) {
+            sum += data[end];
+            maxValue = std::max(maxValue, data[end]);
+            ++end;
+        }
+
+        double resolved = data[i];
+        switch (policy) {
+            case DuplicatePolicy::KEEP_ALL:
+            case DuplicatePolicy::KEEP_FIRST:
+                break;
+            case DuplicatePolicy::KEEP_LAST:
+                resolved = data[end - 1];
+                break;
+            case DuplicatePolicy::AVERAGE:
+                resolved = sum / (end - i);
+                break;
+            case DuplicatePolicy::MAX:
+                resolved = maxValue;
+                break;
+        }
+
+        timestamps[out] = timestamps[i];
+        data[out] = resolved;
+        ++out;
+        i = end;
+    }
+
+    data.resize(out);
+    timestamps.resize(out);
+    invalidateIndexes();
+}
+
+void IoTData::invalidateIndexes() {
+    recentDuplicateCounts.clear();
+    splineCache.invalidate();
+    summarizeBlocks(0);
+}
+
+void IoTData::summarizeBlocks(size_t fromIndex) {
+    size_t first = fromIndex / kSummaryBlockSize;
+    blockSummaries.resize((data.size() + kSummaryBlockSize - 1) / kSummaryBlockSize);
+    for (size_t b = first; b < blockSummaries.size(); ++b) {
+        size_t begin = b * kSummaryBlockSize;
+        blockSummaries[b] = summarizeBlock(data.data() + begin, std::min(kSummaryBlockSize, data.size() - begin));
+    }
+}
+
+void IoTData::includeInBlockSummary(size_t index) {
+    size_t b = index / kSummaryBlockSize;
+    if (b == blockSummaries.size()) {
+        blockSummaries.push_back(emptySummary());
+    }
+    widenSummary(blockSummaries[b], data[index]);
+}
+
+void IoTData::setCalibration(const IoTDataCalibration& newCalibration) {
+    calibration = std::make_shared<const IoTDataCalibration>(newCalibration);
+}
+
+void IoTData::clearCalibration() {
+    calibration.reset();
+}
+
+size_t IoTData::addAppendListener(AppendListener listener) {
+    if (!listener) {
+        throw IoTDataException("Error: Append listener must be callable.");
+    }
+
+    return appendListeners.add(std::move(listener));
+}
+
+void IoTData::removeAppendListener(size_t listenerId) {
+    appendListeners.remove(listenerId);
+}
+
+IoTDataView IoTData::view() const {
+    return IoTDataView(data.data(), timestamps.data(), data.size());
+}
+
+const std::vector<IoTDataBlockSummary>& IoTData::getBlockSummaries() const {
+    return blockSummaries;
+}
+
 void IoTData::filterOutliers(double threshold) {
-    auto it = std::remove_if(data.begin(), data.end(),
-                             [threshold](double value) { return std::abs(value) > threshold; });
-    timestamps.erase(timestamps.begin() + std::distance(data.begin(), it), timestamps.end());
-    data.erase(it, data.end());
+    // Kept points are compacted in place (values and timestamps together); summaries of the compacted
+    // blocks are widened from the input blocks instead of rescanning the kept values
+    std::vector<IoTDataBlockSummary> kept;
+    auto keepRange = [&](size_t begin, size_t count, const IoTDataBlockSummary& summary, size_t out) {
+        if (out != begin) {
+            std::memmove(data.data() + out, data.data() + begin, count * sizeof(double));
+            std::memmove(timestamps.data() + out, timestamps.data() + begin, count * sizeof(double));
+        }
+        kept.resize((out + count + kSummaryBlockSize - 1) / kSummaryBlockSize, emptySummary());
+        for (size_t b = out / kSummaryBlockSize; b < kept.size(); ++b) {
+            widenSummary(kept[b], summary.minimum);
+            widenSummary(kept[b], summary.maximum);
+            kept[b].hasNan = kept[b].hasNan || summary.hasNan;
+        }
+    };
+
+    size_t out = 0;
+    for (size_t b = 0; b < blockSummaries.size(); ++b) {
+        const IoTDataBlockSummary& summary = blockSummaries[b];
+        size_t begin = b * kSummaryBlockSize;
+        size_t count = std::min(kSummaryBlockSize, data.size() - begin);
+
+        if (summary.minimum >= -threshold && summary.maximum <= threshold) {
+            keepRange(begin, count, summary, out);
+            out += count;
+        } else if (!summary.hasNan && (summary.minimum > threshold || summary.maximum < -threshold)) {
+            continue;
+        } else {
+            for (size_t i = begin; i < begin + count; ++i) {
+                double value = data[i];
+                if (!(std::abs(value) > threshold)) {
+                    data[out] = value;
+                    timestamps[out] = timestamps[i];
+                    kept.resize(out / kSummaryBlockSize + 1, emptySummary());
+                    widenSummary(kept[out / kSummaryBlockSize], value);
+                    ++out;
+                }
+            }
+        }
+    }
+
+    if (out == data.size()) {
+        return;
+    }
+    data.resize(out);
+    timestamps.resize(out);
+    recentDuplicateCounts.clear();
+    splineCache.invalidate();
+    blockSummaries = std::move(kept);
 }
 
 double IoTData::calculateMean() const {
-    if (data.empty()) {
-        throw IoTDataEmptyException("Error: No data available for mean calculation.");
-    }
+    return calculateMean(getDefaultSummationMethod());
+}
+
+double IoTData::calculateStandardDeviation() const {
+    return calculateStandardDeviation(getDefaultSummationMethod());
+}
+
+double IoTData::calculateMean(SummationMethod method) const {
+    return calculateAggregate(method).getMean();
+}
 
-    if (std::any_of(data.begin(), data.end(), std::isnan)) {
-        throw IoTDataException("Error: Data contains NaN (Not a Number) values.");
+double IoTData::calculateStandardDeviation(SummationMethod method) const {
+    if (data.size() < 2) {
+        throw IoTDataInsufficientException("Error: Insufficient data for standard deviation calculation.");
     }
 
-    if (std::any_of(data.begin(), data.end(), std::isinf)) {
-        throw IoTDataException("Error: Data contains infinite values.");
+    return calculateAggregate(method).getStandardDeviation();
+}
+
+IoTDataAggregate IoTData::calculateAggregate(size_t threadCount) const {
+    return calculateAggregate(getDefaultSummationMethod(), threadCount);
+}
+
+IoTDataAggregate IoTData::calculateAggregate(SummationMethod method, size_t threadCount) const {
+    return IoTDataAggregate::fromValues(data.data(), data.size(), method, threadCount);
+}
+
+void IoTData::setDefaultSummationMethod(SummationMethod method) {
+    defaultSummationMethod.store(method, std::memory_order_relaxed);
+}
+
+SummationMethod IoTData::getDefaultSummationMethod() {
+    return defaultSummationMethod.load(std::memory_order_relaxed);
+}
+
+void IoTData::calculateCutMoments(double trimPercentage, bool winsorize, size_t threadCount, double& mean,
+                                  double& variance) const {
+    if (!(trimPercentage >= 0.0 && trimPercentage < 100.0)) {
+        throw IoTDataException("Error: Trim percentage must be at least 0 and below 100.");
     }
 
-    if (std::any_of(data.begin(), data.end(), [](double value) { return std::isnan(value) || std::isinf(value); })) {
+    size_t count = data.size();
+    size_t cut = static_cast<size_t>(count * trimPercentage / 200.0);
+    std::vector<double> cutValues = IoTDataSort::selectRanks(data.data(), count, {cut, count - 1 - cut}, threadCount);
+    double low = cutValues[0];
+    double high = cutValues[1];
+    if (std::isnan(high)) {
         throw IoTDataException("Error: Data contains invalid values (NaN or infinity).");
     }
 
-    double sum = std::accumulate(data.begin(), data.end(), 0.0);
+    // One parallel pass: tie counts at both cut values and shifted sums of the values strictly between
+    struct Partial {
+        size_t atOrBelowLow = 0;
+        size_t atOrAboveHigh = 0;
+        double sum = 0.0;
+        double sumSquares = 0.0;
+    };
+    threadCount = IoTDataSort::resolveThreadCount(threadCount, count);
+    std::vector<Partial> partials(threadCount);
+    IoTDataSort::parallelChunks(threadCount, count, [&](size_t t, size_t begin, size_t end) {
+        Partial local;
+        for (size_t i = begin; i < end; ++i) {
+            double value = data[i];
+            if (value <= low) {
+                ++local.atOrBelowLow;
+            } else if (value >= high) {
+                ++local.atOrAboveHigh;
+            } else {
+                double d = value - low;
+                local.sum += d;
+                local.sumSquares += d * d;
+            }
+        }
+        partials[t] = local;
+    });
+
+    Partial total;
+    for (const Partial& partial : partials) {
+        total.atOrBelowLow += partial.atOrBelowLow;
+        total.atOrAboveHigh += partial.atOrAboveHigh;
+        total.sum += partial.sum;
+        total.sumSquares += partial.sumSquares;
+    }
 
-    if (std::isnan(sum) || std::isinf(sum)) {
+    if (low == high) {
+        mean = low;
+        variance = 0.0;
+        return;
+    }
+
+    // Values equal to a cut value sit on both sides of the cut rank; only those inside it are kept
+    size_t highCount = winsorize ? total.atOrAboveHigh : total.atOrAboveHigh - cut;
+    size_t kept = winsorize ? count : count - 2 * cut;
+    double spread = high - low;
+    double sum = total.sum + highCount * spread;
+    double sumSquares = total.sumSquares + highCount * spread * spread;
+
+    mean = low + sum / kept;
+    variance = std::max(0.0, (sumSquares - sum * sum / kept) / kept);
+    if (!std::isfinite(mean) || !std::isfinite(variance)) {
         throw IoTDataException("Error: Sum of data values resulted in an invalid value (NaN or infinity).");
     }
+}
 
-    return sum / data.size();
+double IoTData::calculateTrimmedMean(double trimPercentage, size_t threadCount) const {
+    if (data.empty()) {
+        throw IoTDataEmptyException("Error: No data available for trimmed mean calculation.");
+    }
+
+    double mean;
+    double variance;
+    calculateCutMoments(trimPercentage, false, threadCount, mean, variance);
+    return mean;
 }
 
-double IoTData::calculateStandardDeviation() const {
+double IoTData::calculateWinsorizedMean(double trimPercentage, size_t threadCount) const {
+    if (data.empty()) {
+        throw IoTDataEmptyException("Error: No data available for winsorized mean calculation.");
+    }
+
+    double mean;
+    double variance;
+    calculateCutMoments(trimPercentage, true, threadCount, mean, variance);
+    return mean;
+}
+
+double IoTData::calculateWinsorizedStandardDeviation(double trimPercentage, size_t threadCount) const {
     if (data.size() < 2) {
         throw IoTDataInsufficientException("Error: Insufficient data for standard deviation calculation.");
     }
 
-    double mean = calculateMean();
+    double mean;
+    double variance;
+    calculateCutMoments(trimPercentage, true, threadCount, mean, variance);
+    return std::sqrt(variance);
+}
+
+double IoTData::calculateMean(const IoTDataSelection& selection) const {
+    if (selection.size() != data.size()) {
+        throw IoTDataException("Error: Selection does not match the number of data points.");
+    }
+
+    size_t selected = selection.count();
+    if (selected == 0) {
+        throw IoTDataEmptyException("Error: No selected data available for mean calculation.");
+    }
+
+    // Fully selected words are summed contiguously; partial words walk their set bits
     double sum = 0.0;
+    const uint64_t* words = selection.wordData();
+    for (size_t w = 0; w < selection.wordCount(); ++w) {
+        uint64_t bits = words[w];
+        if (bits == ~uint64_t(0)) {
+            const double* block = data.data() + w * 64;
+            for (size_t j = 0; j < 64; ++j) {
+                sum += block[j];
+            }
+        } else {
+            while (bits != 0) {
+                sum += data[w * 64 + IoTDataBits::countTrailingZeros(bits)];
+                bits &= bits - 1;
+            }
+        }
+    }
+
+    if (std::isnan(sum) || std::isinf(sum)) {
+        throw IoTDataException("Error: Sum of data values resulted in an invalid value (NaN or infinity).");
+    }
+
+    return sum / selected;
+}
 
-    for (const double& value : data) {
-        sum += std::pow(value - mean, 2);
+double IoTData::calculateStandardDeviation(const IoTDataSelection& selection) const {
+    if (selection.count() < 2) {
+        throw IoTDataInsufficientException("Error: Insufficient selected data for standard deviation calculation.");
     }
 
-    return std::sqrt(sum / data.size());
+    double mean = calculateMean(selection);
+    double sum = 0.0;
+
+    selection.forEachSelected([this, mean, &sum](size_t index) {
+        double deviation = data[index] - mean;
+        sum += deviation * deviation;
+    });
+
+    return std::sqrt(sum / selection.count());
 }
 
 void IoTData::scaleData(double scaleFactor) {
     std::transform(data.begin(), data.end(), data.begin(),
                    [scaleFactor](double value) { return value * scaleFactor; });
+    splineCache.invalidate();
+    // Positive finite factors cannot turn a value into NaN, so the bounds scale with the values
+    if (scaleFactor > 0.0 && std::isfinite(scaleFactor)) {
+        mapSummaries(blockSummaries, [scaleFactor](double bound) { return bound * scaleFactor; });
+    } else {
+        summarizeBlocks(0);
+    }
 }
 
-void IoTData::normalizeData() {
-    double mean = calculateMean();
-    double stdev = calculateStandardDeviation();
+void IoTData::normalizeData(NormalizationMethod method) {
+    if (data.empty()) {
+        throw IoTDataEmptyException("Error: No data available for normalization.");
+    }
 
-    std::transform(data.begin(), data.end(), data.begin(),
-                   [mean, stdev](double value) { return (value - mean) / stdev; });
+    // Each method gathers its statistics in one fused pass, followed by a single rescale pass
+    double center = 0.0;
+    double spread = 0.0;
+    switch (method) {
+        case NormalizationMethod::Z_SCORE: {
+            if (data.size() < 2) {
+                throw IoTDataInsufficientException("Error: Insufficient data for z-score normalization.");
+            }
+            // Shifting by the first value keeps the single-pass variance accurate for large offsets
+            double sum;
+            double sumSquares;
+            IoTDataSimd::shiftedSums(data.data(), data.size(), data.front(), sum, sumSquares);
+            if (!std::isfinite(sum) || !std::isfinite(sumSquares)) {
+                throw IoTDataException("Error: Data contains invalid values (NaN or infinity).");
+            }
+            double count = static_cast<double>(data.size());
+            center = data.front() + sum / count;
+            spread = std::sqrt(std::max(0.0, (sumSquares - sum * sum / count) / count));
+            break;
+        }
+
+        case NormalizationMethod::MIN_MAX: {
+            double minimum;
+            double maximum;
+            if (!IoTDataSimd::minMax(data.data(), data.size(), minimum, maximum) || !std::isfinite(minimum) ||
+                !std::isfinite(maximum)) {
+                throw IoTDataException("Error: Data contains invalid values (NaN or infinity).");
+            }
+            center = minimum;
+            spread = maximum - minimum;
+            break;
+        }
+
+        case NormalizationMethod::ROBUST: {
+            if (std::any_of(data.begin(), data.end(), [](double value) { return !std::isfinite(value); })) {
+                throw IoTDataException("Error: Data contains invalid values (NaN or infinity).");
+            }
+            std::vector<double> scratch(data);
+            double lowerQuartile = selectQuantile(scratch, 0.25);
+            double upperQuartile = selectQuantile(scratch, 0.75);
+            center = selectQuantile(scratch, 0.5);
+            spread = upperQuartile - lowerQuartile;
+            break;
+        }
+    }
+
+    // A constant series (zero spread) is only centred instead of dividing by zero
+    if (!(spread > 0.0) || !std::isfinite(spread)) {
+        spread = 1.0;
+    }
+
+    // Subtract before scaling so large offsets do not cost precision
+    double inverseSpread = 1.0 / spread;
+    auto rescale = [center, inverseSpread](double value) { return (value - center) * inverseSpread; };
+    std::transform(data.begin(), data.end(), data.begin(), rescale);
+    splineCache.invalidate();
+    mapSummaries(blockSummaries, rescale);
+}
+
+void IoTData::calibrateData(const IoTDataCalibration& calibration) {
+    calibration.apply(data.data(), data.data(), data.size());
+    splineCache.invalidate();
+    summarizeBlocks(0);
 }
 
 void IoTData::exportDataToFile(const std::string& filename) const {
-    std::ofstream outputFile(filename);
+    auto endsWith = [&filename](const std::string& suffix) {
+        return filename.size() >= suffix.size() &&
+               filename.compare(filename.size() - suffix.size(), suffix.size(), suffix) == 0;
+    };
+
+    IoTDataExportOptions options;
+    if (endsWith(".gz")) {
+        options.compression = CompressionFormat::GZIP;
+        options.format = endsWith(".bin.gz") ? ExportFormat::BINARY : ExportFormat::CSV;
+    }
+    exportDataToFile(filename, options);
+}
+
+void IoTData::exportDataToFile(const std::string& filename, const IoTDataExportOptions& options) const {
+    if (options.compression == CompressionFormat::GZIP) {
+        IoTDataGzip::writeFile(filename, data.data(), timestamps.data(), data.size(), options.format,
+                               options.compressionLevel, options.threadCount);
+        return;
+    }
+
+    std::ofstream outputFile(filename, options.format == ExportFormat::BINARY ? std::ios::binary : std::ios::out);
 
     if (!outputFile.is_open()) {
         throw IoTDataFileException("Error: Unable to open the file for data export.");
     }
 
-    for (size_t i = 0; i < data.size(); ++i) {
-        outputFile << timestamps[i] << "," << data[i] << '\n';
+    if (options.format == ExportFormat::BINARY) {
+        IoTDataBinaryFormat::writeHeader(outputFile);
+        IoTDataBinaryFormat::writeBlocks(outputFile, data.data(), timestamps.data(), data.size());
+    } else {
+        for (size_t i = 0; i < data.size(); ++i) {
+            outputFile << timestamps[i] << "," << data[i] << '\n';
+        }
     }
 
     outputFile.close();
 }
 
-void IoTData::importDataFromFile(const std::string& filename) {
+IoTDataImportReport IoTData::importDataFromFile(const std::string& filename, const IoTDataImportOptions& options) {
     std::ifstream inputFile(filename);
 
     if (!inputFile.is_open()) {
         throw IoTDataFileException("Error: Unable to open the file for data import.");
     }
 
-    data.clear();
-    timestamps.clear();
-
-    double timestamp, value;
-    char comma;
-    while (inputFile >> timestamp >> comma >> value) {
-        if (comma != ',') {
-            throw IoTDataFileException("Error: Invalid file format. Expected comma-separated values.");
+    // Points are parsed into local columns, so a failed import leaves the series untouched
+    std::vector<double> importedData;
+    std::vector<double> importedTimestamps;
+    IoTDataImportReport report;
+
+    if (IoTDataGzip::isGzipFile(filename)) {
+        inputFile.close();
+        IoTDataGzip::readFile(filename, importedData, importedTimestamps, options.threadCount);
+    } else if (IoTDataBinaryFormat::isBinaryFile(filename)) {
+        inputFile.close();
+        IoTDataBinaryFormat::readFile(filename, importedData, importedTimestamps, report.corruptedRanges);
+        if (!report.corruptedRanges.empty() && options.corruption == CorruptionPolicy::FAIL) {
+            std::string message = "Error: Corrupted binary blocks at byte ranges";
+            for (const IoTDataCorruptedRange& range : report.corruptedRanges) {
+                message += " [" + std::to_string(range.byteOffset) + ", " +
+                           std::to_string(range.byteOffset + range.byteLength) + ")";
+            }
+            throw IoTDataFileException(message + ".");
+        }
+    } else {
+        double timestamp, value;
+        char comma;
+        while (inputFile >> timestamp >> comma >> value) {
+            if (comma != ',') {
+                throw IoTDataFileException("Error: Invalid file format. Expected comma-separated values.");
+            }
+            importedTimestamps.push_back(timestamp);
+            importedData.push_back(value);
         }
-        timestamps.push_back(timestamp);
-        data.push_back(value);
     }
 
-    if (data.empty()) {
+    if (importedData.empty()) {
         throw IoTDataFileException("Error: No data found in the input file.");
     }
 
     inputFile.close();
+    data.swap(importedData);
+    timestamps.swap(importedTimestamps);
+    invalidateIndexes();
+
+    if (options.sortByTimestamp) {
+        sortByTimestamp();
+    }
+
+    resolveDuplicateTimestamps(options.duplicates);
+    report.importedPoints = data.size();
+    return report;
+}
+
+void IoTData::sortByTimestamp() {
+    // interpolateData and the other time-based functions rely on ascending timestamps
+    if (IoTDataSort::radixSortByKey(timestamps, data)) {
+        invalidateIndexes();
+    }
 }
 
 void IoTData::plotData() const {
-    // Hypothetical data visualization code (not implemented at this time)
-    std::cout << "Data plot: [";
-    for (size_t i = 0; i < data.size(); ++i) {
-        std::cout << "(" << timestamps[i] << ", " << data[i] << "), ";
+    // Listing every point floods logs; charts are rendered to files by the overloads below
+    if (data.empty()) {
+        std::cout << "Data plot: no data" << std::endl;
+        return;
     }
-    std::cout << "]" << std::endl;
+
+    auto valueRange = std::minmax_element(data.begin(), data.end());
+    auto timeRange = std::minmax_element(timestamps.begin(), timestamps.end());
+    std::cout << "Data plot: " << data.size() << " points, time [" << *timeRange.first << ", "
+              << *timeRange.second << "], value [" << *valueRange.first << ", " << *valueRange.second << "]"
+              << std::endl;
+}
+
+void IoTData::plotData(const std::string& filename) const {
+    IoTDataPlotOptions options;
+    bool isPng = filename.size() >= 4 && filename.compare(filename.size() - 4, 4, ".png") == 0;
+    options.format = isPng ? PlotFormat::PNG : PlotFormat::SVG;
+    plotData(filename, options);
+}
+
+void IoTData::plotData(const std::string& filename, const IoTDataPlotOptions& options) const {
+    IoTDataPlot::render(view(), filename, options);
 }
 
 std::vector<double> IoTData::calculateRollingMean(size_t windowSize) const {
@@ -204,6 +908,7 @@ void IoTData::trimData(double trimPercentage) {
         data.erase(data.end() - trimCount, data.end());
         timestamps.erase(timestamps.begin(), timestamps.begin() + trimCount);
         timestamps.erase(timestamps.end() - trimCount, timestamps.end());
+        invalidateIndexes();
     }
 }
 
@@ -276,7 +981,14 @@ std::vector<double> IoTData::interpolateData(const std::vector<double>& newTimes
 
         case InterpolationMethod::CUBIC_SPLINE:
             {
-                std::vector<double> coeffs = calculateSplineCoefficients(timestamps, data);
+                {
+                    std::lock_guard<std::mutex> lock(splineCache.mutex);
+                    if (!splineCache.valid) {
+                        splineCache.coefficients = calculateSplineCoefficients(timestamps, data);
+                        splineCache.valid = true;
+                    }
+                }
+                const std::vector<double>& coeffs = splineCache.coefficients;
                 for (double t : newTimestamps) {
                     auto it = std::lower_bound(timestamps.begin(), timestamps.end(), t);
                     if (it == timestamps.begin()) {
@@ -307,6 +1019,9 @@ std::vector<double> IoTData::calculateSplineCoefficients(const std::vector<doubl
 
     for (size_t i = 0; i < n - 1; ++i) {
         h[i] = x[i + 1] - x[i];
+        if (!(h[i] > 0.0)) {
+            throw IoTDataException("Error: Timestamps must be strictly increasing for cubic spline interpolation.");
+        }
         b[i] = (y[i + 1] - y[i]) / h[i];
     }
 
@@ -0,0 +1,233 @@
+// IoTDataAggregate.cpp
+#include "IoTDataAggregate.h"
+#include "IoTDataException.h"
+#include "IoTDataSimd.h"
+#include "IoTDataSort.h"
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+constexpr char kAggregateMagic[4] = {'I', 'A', 'G', '1'};
+
+template <typename T>
+void appendValue(std::vector<uint8_t>& buffer, T value) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+T readValue(const uint8_t* bytes, size_t& cursor) {
+    T value;
+    std::memcpy(&value, bytes + cursor, sizeof(T));
+    cursor += sizeof(T);
+    return value;
+}
+
+} // namespace
+
+IoTDataAggregate::IoTDataAggregate(uint64_t count, uint64_t nanCount, uint64_t infiniteCount, double sum,
+                                   double m2, double minimum, double maximum)
+    : count(count), nanCount(nanCount), infiniteCount(infiniteCount), sum(sum), m2(m2), minimum(minimum),
+      maximum(maximum) {}
+
+IoTDataAggregate IoTDataAggregate::fromChunk(const double* values, size_t count, SummationMethod method) {
+    if (count == 0) {
+        return IoTDataAggregate();
+    }
+
+    // Common case: every value finite, so the moments come from the SIMD kernels (two passes for accuracy)
+    double minimum;
+    double maximum;
+    if (IoTDataSimd::minMax(values, count, minimum, maximum) && std::isfinite(minimum) && std::isfinite(maximum)) {
+        if (method == SummationMethod::COMPENSATED) {
+            // Corrected two-pass: the residual sum of deviations removes the error left in the mean
+            double sum = IoTDataSimd::compensatedSum(values, count);
+            double deviations;
+            double squares;
+            IoTDataSimd::compensatedShiftedSums(values, count, sum / count, deviations, squares);
+            return IoTDataAggregate(count, 0, 0, sum, squares - deviations * deviations / count, minimum, maximum);
+        }
+        double sum = IoTDataSimd::sum(values, count);
+        double m2 = IoTDataSimd::sumSquaredDeviations(values, count, sum / count);
+        return IoTDataAggregate(count, 0, 0, sum, m2, minimum, maximum);
+    }
+
+    IoTDataAggregate aggregate;
+    for (size_t i = 0; i < count; ++i) {
+        aggregate.add(values[i]);
+    }
+    return aggregate;
+}
+
+IoTDataAggregate IoTDataAggregate::fromValues(const double* values, size_t count, size_t threadCount) {
+    return fromValues(values, count, IoTData::getDefaultSummationMethod(), threadCount);
+}
+
+IoTDataAggregate IoTDataAggregate::fromValues(const double* values, size_t count, SummationMethod method,
+                                              size_t threadCount) {
+    size_t threads = IoTDataSort::resolveThreadCount(threadCount, count);
+    if (threads == 1) {
+        return fromChunk(values, count, method);
+    }
+
+    std::vector<IoTDataAggregate> partials(threads);
+    IoTDataSort::parallelChunks(threads, count, [&](size_t t, size_t begin, size_t end) {
+        partials[t] = fromChunk(values + begin, end - begin, method);
+    });
+    for (size_t t = 1; t < threads; ++t) {
+        partials[0].merge(partials[t]);
+    }
+    return partials[0];
+}
+
+void IoTDataAggregate::add(double value) {
+    if (std::isnan(value)) {
+        ++nanCount;
+        return;
+    }
+    if (std::isinf(value)) {
+        ++infiniteCount;
+        return;
+    }
+
+    // Welford update expressed on the running sum
+    double delta = count > 0 ? value - sum / count : 0.0;
+    ++count;
+    sum += value;
+    m2 += delta * (value - sum / count);
+
+    if (count == 1) {
+        minimum = maximum = value;
+    } else {
+        minimum = value < minimum ? value : minimum;
+        maximum = value > maximum ? value : maximum;
+    }
+}
+
+void IoTDataAggregate::merge(const IoTDataAggregate& other) {
+    nanCount += other.nanCount;
+    infiniteCount += other.infiniteCount;
+    if (other.count == 0) {
+        return;
+    }
+    if (count == 0) {
+        count = other.count;
+        sum = other.sum;
+        m2 = other.m2;
+        minimum = other.minimum;
+        maximum = other.maximum;
+        return;
+    }
+
+    // Pairwise combination of the squared deviations around the two means
+    double a = static_cast<double>(count);
+    double b = static_cast<double>(other.count);
+    double delta = other.sum / b - sum / a;
+    m2 += other.m2 + delta * delta * (a * b / (a + b));
+    sum += other.sum;
+    count += other.count;
+    minimum = other.minimum < minimum ? other.minimum : minimum;
+    maximum = other.maximum > maximum ? other.maximum : maximum;
+}
+
+void IoTDataAggregate::reset() {
+    *this = IoTDataAggregate();
+}
+
+size_t IoTDataAggregate::attach(IoTData& series) {
+    // The aggregate must outlive the series, or the listener must be removed first
+    return series.addAppendListener([this](double value, double) { add(value); });
+}
+
+std::vector<uint8_t> IoTDataAggregate::serialize() const {
+    std::vector<uint8_t> bytes(kAggregateMagic, kAggregateMagic + sizeof(kAggregateMagic));
+    bytes.reserve(kSerializedSize);
+    appendValue(bytes, count);
+    appendValue(bytes, nanCount);
+    appendValue(bytes, infiniteCount);
+    appendValue(bytes, sum);
+    appendValue(bytes, m2);
+    appendValue(bytes, minimum);
+    appendValue(bytes, maximum);
+    return bytes;
+}
+
+IoTDataAggregate IoTDataAggregate::deserialize(const uint8_t* bytes, size_t size) {
+    if (size != kSerializedSize || std::memcmp(bytes, kAggregateMagic, sizeof(kAggregateMagic)) != 0) {
+        throw IoTDataException("Error: Invalid serialized aggregate.");
+    }
+
+    size_t cursor = sizeof(kAggregateMagic);
+    IoTDataAggregate aggregate;
+    aggregate.count = readValue<uint64_t>(bytes, cursor);
+    aggregate.nanCount = readValue<uint64_t>(bytes, cursor);
+    aggregate.infiniteCount = readValue<uint64_t>(bytes, cursor);
+    aggregate.sum = readValue<double>(bytes, cursor);
+    aggregate.m2 = readValue<double>(bytes, cursor);
+    aggregate.minimum = readValue<double>(bytes, cursor);
+    aggregate.maximum = readValue<double>(bytes, cursor);
+    return aggregate;
+}
+
+double IoTDataAggregate::getMean() const {
+    if (count + nanCount + infiniteCount == 0) {
+        throw IoTDataEmptyException("Error: No data available for mean calculation.");
+    }
+    if (nanCount > 0) {
+        throw IoTDataException("Error: Data contains NaN (Not a Number) values.");
+    }
+    if (infiniteCount > 0) {
+        throw IoTDataException("Error: Data contains infinite values.");
+    }
+    if (std::isnan(sum) || std::isinf(sum)) {
+        throw IoTDataException("Error: Sum of data values resulted in an invalid value (NaN or infinity).");
+    }
+    return sum / count;
+}
+
+double IoTDataAggregate::getVariance() const {
+    if (count + nanCount + infiniteCount < 2) {
+        throw IoTDataInsufficientException("Error: Insufficient data for standard deviation calculation.");
+    }
+    getMean();
+    return m2 / count;
+}
+
+double IoTDataAggregate::getStandardDeviation() const {
+    return std::sqrt(getVariance());
+}
+
+double IoTDataAggregate::getMinimum() const {
+    if (count == 0) {
+        throw IoTDataEmptyException("Error: No finite data available for minimum calculation.");
+    }
+    return minimum;
+}
+
+double IoTDataAggregate::getMaximum() const {
+    if (count == 0) {
+        throw IoTDataEmptyException("Error: No finite data available for maximum calculation.");
+    }
+    return maximum;
+}
+
+uint64_t IoTDataAggregate::getCount() const {
+    return count;
+}
+
+uint64_t IoTDataAggregate::getNanCount() const {
+    return nanCount;
+}
+
+uint64_t IoTDataAggregate::getInfiniteCount() const {
+    return infiniteCount;
+}
+
+double IoTDataAggregate::getSum() const {
+    return sum;
+}
+
+double IoTDataAggregate::getM2() const {
+    return m2;
+}
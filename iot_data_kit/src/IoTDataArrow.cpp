@@ -0,0 +1,191 @@
+// IoTDataArrow.cpp
+#include "IoTDataArrow.h"
+#include "IoTDataException.h"
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace {
+
+const char* kTimestampName = "timestamp";
+const char* kValueName = "value";
+
+// Columns moved in by exportSeries (empty for exportView), shared by the parent array and its children
+struct ExportedColumns {
+    std::vector<double> values;
+    std::vector<double> timestamps;
+};
+
+// Behind each child array: its buffer list and a reference to the columns, so a child the consumer
+// moved out stays valid after the parent is released
+struct ExportedChild {
+    std::shared_ptr<ExportedColumns> columns;
+    const void* buffers[2] = {nullptr, nullptr};
+};
+
+// Behind the parent array: the child structs handed out through children
+struct ExportedArray {
+    std::shared_ptr<ExportedColumns> columns;
+    const void* structBuffers[1] = {nullptr};
+    ArrowArray childArrays[2];
+    ArrowArray* children[2];
+};
+
+struct ExportedSchema {
+    ArrowSchema childSchemas[2];
+    ArrowSchema* children[2];
+};
+
+void releaseChildArray(ArrowArray* array) {
+    delete static_cast<ExportedChild*>(array->private_data);
+    array->release = nullptr;
+}
+
+void releaseArray(ArrowArray* array) {
+    ExportedArray* holder = static_cast<ExportedArray*>(array->private_data);
+    for (int64_t c = 0; c < array->n_children; ++c) {
+        if (array->children[c]->release != nullptr) {
+            array->children[c]->release(array->children[c]);
+        }
+    }
+    delete holder;
+    array->release = nullptr;
+}
+
+void releaseChildSchema(ArrowSchema* schema) {
+    schema->release = nullptr;
+}
+
+void releaseSchema(ArrowSchema* schema) {
+    ExportedSchema* holder = static_cast<ExportedSchema*>(schema->private_data);
+    for (int64_t c = 0; c < schema->n_children; ++c) {
+        if (schema->children[c]->release != nullptr) {
+            schema->children[c]->release(schema->children[c]);
+        }
+    }
+    delete holder;
+    schema->release = nullptr;
+}
+
+void fillChildArray(ArrowArray& child, const std::shared_ptr<ExportedColumns>& columns, const double* column,
+                    int64_t length) {
+    ExportedChild* holder = new ExportedChild;
+    holder->columns = columns;
+    holder->buffers[0] = nullptr;  // No validity bitmap: every point is valid
+    holder->buffers[1] = column;
+    child = ArrowArray{length, 0, 0, 2, 0, holder->buffers, nullptr, nullptr, releaseChildArray, holder};
+}
+
+void exportColumns(std::shared_ptr<ExportedColumns> columns, const double* values, const double* timestamps,
+                   size_t size, ArrowArray* outArray, ArrowSchema* outSchema) {
+    if (outArray == nullptr || outSchema == nullptr) {
+        throw IoTDataException("Error: Arrow export targets must not be null.");
+    }
+
+    int64_t length = static_cast<int64_t>(size);
+    ExportedArray* holder = new ExportedArray;
+    holder->columns = columns;
+    fillChildArray(holder->childArrays[0], columns, timestamps, length);
+    fillChildArray(holder->childArrays[1], columns, values, length);
+    holder->children[0] = &holder->childArrays[0];
+    holder->children[1] = &holder->childArrays[1];
+    *outArray = ArrowArray{length, 0, 0, 1, 2, holder->structBuffers, holder->children, nullptr, releaseArray, holder};
+
+    ExportedSchema* schema = new ExportedSchema;
+    schema->childSchemas[0] = ArrowSchema{"g", kTimestampName, nullptr, 0, 0, nullptr, nullptr, releaseChildSchema, nullptr};
+    schema->childSchemas[1] = ArrowSchema{"g", kValueName, nullptr, 0, 0, nullptr, nullptr, releaseChildSchema, nullptr};
+    schema->children[0] = &schema->childSchemas[0];
+    schema->children[1] = &schema->childSchemas[1];
+    *outSchema = ArrowSchema{"+s", "", nullptr, 0, 2, schema->children, nullptr, releaseSchema, schema};
+}
+
+// Index of the float64 child with the given name, or -1
+int64_t findChild(const ArrowSchema* schema, const char* name) {
+    for (int64_t c = 0; c < schema->n_children; ++c) {
+        const ArrowSchema* child = schema->children[c];
+        if (child->name != nullptr && std::strcmp(child->name, name) == 0) {
+            if (std::strcmp(child->format, "g") != 0) {
+                throw IoTDataException(std::string("Error: Arrow column '") + name + "' must be float64.");
+            }
+            return c;
+        }
+    }
+    return -1;
+}
+
+const double* childColumn(const ArrowArray* parent, int64_t index) {
+    const ArrowArray* child = parent->children[index];
+    if (child->n_buffers != 2 || child->length < parent->length + parent->offset) {
+        throw IoTDataException("Error: Arrow column has an unexpected layout.");
+    }
+
+    // A validity bitmap is only acceptable when it marks no nulls
+    if (child->null_count != 0 && !(child->null_count == -1 && child->buffers[0] == nullptr)) {
+        throw IoTDataException("Error: Arrow columns with null values cannot be imported.");
+    }
+
+    return static_cast<const double*>(child->buffers[1]) + child->offset + parent->offset;
+}
+
+} // namespace
+
+void IoTDataArrow::exportSeries(IoTData&& series, ArrowArray* outArray, ArrowSchema* outSchema) {
+    std::shared_ptr<ExportedColumns> columns = std::make_shared<ExportedColumns>();
+    columns->values = std::move(series.data);
+    columns->timestamps = std::move(series.timestamps);
+    series.clearData();
+
+    exportColumns(columns, columns->values.data(), columns->timestamps.data(), columns->values.size(), outArray,
+                  outSchema);
+}
+
+void IoTDataArrow::exportView(const IoTDataView& view, ArrowArray* outArray, ArrowSchema* outSchema) {
+    exportColumns(std::make_shared<ExportedColumns>(), view.values(), view.timestamps(), view.size(), outArray,
+                  outSchema);
+}
+
+IoTDataArrowColumns::IoTDataArrowColumns(ArrowArray* sourceArray, const ArrowSchema* schema) {
+    if (sourceArray == nullptr || sourceArray->release == nullptr || schema == nullptr || schema->release == nullptr) {
+        throw IoTDataException("Error: Arrow array or schema is null or already released.");
+    }
+
+    // Move the array in; from here on this object is responsible for releasing it
+    array = *sourceArray;
+    sourceArray->release = nullptr;
+
+    try {
+        if (std::strcmp(schema->format, "+s") != 0 || schema->n_children != array.n_children) {
+            throw IoTDataException("Error: Arrow series must be a struct array.");
+        }
+        if (array.null_count > 0) {
+            throw IoTDataException("Error: Arrow series with null rows cannot be imported.");
+        }
+
+        int64_t timestampIndex = findChild(schema, kTimestampName);
+        int64_t valueIndex = findChild(schema, kValueName);
+        if (timestampIndex < 0 || valueIndex < 0) {
+            throw IoTDataException("Error: Arrow series needs 'timestamp' and 'value' columns.");
+        }
+
+        columns = IoTDataView(childColumn(&array, valueIndex), childColumn(&array, timestampIndex),
+                              static_cast<size_t>(array.length));
+    } catch (...) {
+        array.release(&array);
+        throw;
+    }
+}
+
+IoTDataArrowColumns::~IoTDataArrowColumns() {
+    if (array.release != nullptr) {
+        array.release(&array);
+    }
+}
+
+IoTDataView IoTDataArrowColumns::view() const {
+    return columns;
+}
+
+IoTData IoTDataArrowColumns::toIoTData() const {
+    return IoTData(std::vector<double>(columns.values(), columns.values() + columns.size()),
+                   std::vector<double>(columns.timestamps(), columns.timestamps() + columns.size()));
+}
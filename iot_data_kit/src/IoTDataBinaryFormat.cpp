@@ -0,0 +1,394 @@
+// IoTDataBinaryFormat.cpp
+#include "IoTDataBinaryFormat.h"
+#include "IoTDataChecksum.h"
+#include "IoTDataException.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+namespace IoTDataBinaryFormat {
+
+namespace {
+
+const char kFileMagic[kMagicSize] = {'I', 'O', 'T', 'B', 'I', 'N', '0', '1'};
+constexpr uint32_t kBlockMagic = 0x4B4C4249;          // "IBLK", no checksum (still read)
+constexpr uint32_t kChecksumBlockMagic = 0x434C4249;  // "IBLC"
+constexpr uint64_t kOverlapThreshold = 4 << 20;       // Smaller files are verified inline
+constexpr size_t kScanWindow = 64 * 1024;
+
+size_t headerSize(uint32_t magic) {
+    return magic == kChecksumBlockMagic ? 12 : 8;
+}
+
+uint64_t blockSize(uint32_t magic, uint32_t count) {
+    return headerSize(magic) + 2 * static_cast<uint64_t>(count) * sizeof(double);
+}
+
+// CRC-32C of the count field followed by both columns, as laid out in the file
+uint32_t blockChecksum(uint32_t count, const double* values, const double* timestamps) {
+    uint32_t crc = IoTDataChecksum::crc32c(&count, sizeof(count));
+    crc = IoTDataChecksum::crc32c(values, count * sizeof(double), crc);
+    return IoTDataChecksum::crc32c(timestamps, count * sizeof(double), crc);
+}
+
+// A block header whose block would end by end
+bool plausibleHeader(uint32_t magic, uint32_t count, uint64_t offset, uint64_t end, bool checksummedOnly) {
+    bool known = magic == kChecksumBlockMagic || (magic == kBlockMagic && !checksummedOnly);
+    return known && count <= kMaxBlockPoints && offset + blockSize(magic, count) <= end;
+}
+
+// Offset of the first plausible block header in [from, end), or end
+uint64_t scanForBlock(std::ifstream& input, uint64_t from, uint64_t end, bool checksummedOnly) {
+    std::vector<char> window(kScanWindow + 7);
+    for (uint64_t position = from; position < end; position += kScanWindow) {
+        size_t size = static_cast<size_t>(std::min<uint64_t>(window.size(), end - position));
+        input.clear();
+        input.seekg(static_cast<std::streamoff>(position));
+        if (size < 8 || !input.read(window.data(), static_cast<std::streamsize>(size))) {
+            break;
+        }
+        for (size_t i = 0; i + 8 <= size && i < kScanWindow; ++i) {
+            uint32_t header[2];
+            std::memcpy(header, window.data() + i, sizeof(header));
+            if (plausibleHeader(header[0], header[1], position + i, end, checksummedOnly)) {
+                return position + i;
+            }
+        }
+    }
+    return end;
+}
+
+// Part of the file in block order: an intact block, a block that failed verification, or unreadable bytes
+struct Segment {
+    uint64_t byteOffset;
+    uint64_t byteLength;
+    size_t columnOffset;
+    uint32_t count;        // 0 for unreadable bytes
+    bool intact;
+    bool checksumFailed;   // A header was trusted here, so the range is rescanned for blocks
+};
+
+// Checks block checksums on a background thread while later blocks are still being read
+// (inline for small files). Columns must not reallocate while jobs are pending.
+class BlockVerifier {
+private:
+    struct Job {
+        size_t segment;
+        const double* values;
+        const double* timestamps;
+        uint32_t count;
+        uint32_t expected;
+    };
+
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<Job> jobs;
+    bool finished = false;
+    std::vector<size_t> failed;
+    std::thread worker;
+
+    static bool check(const Job& job) {
+        return blockChecksum(job.count, job.values, job.timestamps) == job.expected;
+    }
+
+    void run() {
+        while (true) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                ready.wait(lock, [this] { return finished || !jobs.empty(); });
+                if (jobs.empty()) {
+                    return;
+                }
+                job = jobs.front();
+                jobs.pop_front();
+            }
+            if (!check(job)) {
+                failed.push_back(job.segment);
+            }
+        }
+    }
+
+public:
+    explicit BlockVerifier(bool background) {
+        if (background) {
+            worker = std::thread(&BlockVerifier::run, this);
+        }
+    }
+
+    ~BlockVerifier() {
+        finish();
+    }
+
+    void submit(size_t segment, const double* values, const double* timestamps, uint32_t count, uint32_t expected) {
+        Job job{segment, values, timestamps, count, expected};
+        if (!worker.joinable()) {
+            if (!check(job)) {
+                failed.push_back(segment);
+            }
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            jobs.push_back(job);
+        }
+        ready.notify_one();
+    }
+
+    // Segments whose checksum did not match, once every submitted block is checked
+    std::vector<size_t> finish() {
+        if (worker.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                finished = true;
+            }
+            ready.notify_one();
+            worker.join();
+        }
+        return failed;
+    }
+};
+
+struct RecoveredBlock {
+    uint64_t byteOffset;
+    uint64_t byteLength;
+    std::vector<double> values;
+    std::vector<double> timestamps;
+};
+
+// Checksummed blocks inside [from, end), found byte by byte and kept only when they verify
+std::vector<RecoveredBlock> recoverBlocks(std::ifstream& input, uint64_t from, uint64_t end) {
+    std::vector<RecoveredBlock> recovered;
+    while ((from = scanForBlock(input, from, end, true)) < end) {
+        uint32_t header[3];
+        input.clear();
+        input.seekg(static_cast<std::streamoff>(from));
+        input.read(reinterpret_cast<char*>(header), sizeof(header));
+
+        RecoveredBlock block{from, blockSize(header[0], header[1]), std::vector<double>(header[1]),
+                             std::vector<double>(header[1])};
+        input.read(reinterpret_cast<char*>(block.values.data()), header[1] * sizeof(double));
+        input.read(reinterpret_cast<char*>(block.timestamps.data()), header[1] * sizeof(double));
+        if (input && blockChecksum(header[1], block.values.data(), block.timestamps.data()) == header[2]) {
+            from += block.byteLength;
+            recovered.push_back(std::move(block));
+        } else {
+            ++from;
+        }
+    }
+    return recovered;
+}
+
+} // namespace
+
+bool isBinaryFile(const std::string& filename) {
+    std::ifstream input(filename, std::ios::binary);
+    char magic[kMagicSize];
+    return input.read(magic, sizeof(magic)) && std::memcmp(magic, kFileMagic, sizeof(magic)) == 0;
+}
+
+void writeHeader(std::ostream& output) {
+    output.write(kFileMagic, sizeof(kFileMagic));
+}
+
+void writeBlocks(std::ostream& output, const double* values, const double* timestamps, size_t count) {
+    for (size_t begin = 0; begin < count; begin += kMaxBlockPoints) {
+        uint32_t blockCount = static_cast<uint32_t>(std::min(kMaxBlockPoints, count - begin));
+        uint32_t header[3] = {kChecksumBlockMagic, blockCount,
+                              blockChecksum(blockCount, values + begin, timestamps + begin)};
+        output.write(reinterpret_cast<const char*>(header), sizeof(header));
+        output.write(reinterpret_cast<const char*>(values + begin), blockCount * sizeof(double));
+        output.write(reinterpret_cast<const char*>(timestamps + begin), blockCount * sizeof(double));
+    }
+
+    if (!output) {
+        throw IoTDataFileException("Error: Unable to write binary data blocks.");
+    }
+}
+
+void readFile(const std::string& filename, std::vector<double>& values, std::vector<double>& timestamps,
+              std::vector<IoTDataCorruptedRange>& corrupted) {
+    std::ifstream input(filename, std::ios::binary | std::ios::ate);
+    if (!input.is_open()) {
+        throw IoTDataFileException("Error: Unable to open the file for data import.");
+    }
+    uint64_t fileSize = static_cast<uint64_t>(input.tellg());
+    input.seekg(0);
+
+    char magic[kMagicSize];
+    if (!input.read(magic, sizeof(magic)) || std::memcmp(magic, kFileMagic, sizeof(magic)) != 0) {
+        throw IoTDataFileException("Error: Invalid binary file header.");
+    }
+
+    // Every point takes 16 bytes of the file, so this capacity is never exceeded and the verifier can read
+    // finished blocks in place while later blocks are appended
+    size_t base = values.size();
+    values.reserve(base + (fileSize - kMagicSize) / (2 * sizeof(double)));
+    timestamps.reserve(values.capacity());
+
+    std::vector<Segment> segments;
+    BlockVerifier verifier(fileSize >= kOverlapThreshold);
+    uint64_t position = kMagicSize;
+    while (position < fileSize) {
+        uint32_t header[3] = {0, 0, 0};
+        input.read(reinterpret_cast<char*>(header), std::min<uint64_t>(8, fileSize - position));
+        if (!input || !plausibleHeader(header[0], header[1], position, fileSize, false)) {
+            // Unreadable header or truncated block: skip to the next plausible header
+            uint64_t next = scanForBlock(input, position + 1, fileSize, false);
+            segments.push_back({position, next - position, values.size(), 0, false, false});
+            position = next;
+            input.clear();
+            input.seekg(static_cast<std::streamoff>(position));
+            continue;
+        }
+
+        bool checksummed = header[0] == kChecksumBlockMagic;
+        if (checksummed) {
+            input.read(reinterpret_cast<char*>(header + 2), sizeof(header[2]));
+        }
+        size_t offset = values.size();
+        values.resize(offset + header[1]);
+        timestamps.resize(offset + header[1]);
+        if (!input.read(reinterpret_cast<char*>(values.data() + offset), header[1] * sizeof(double)) ||
+            !input.read(reinterpret_cast<char*>(timestamps.data() + offset), header[1] * sizeof(double))) {
+            throw IoTDataFileException("Error: Unable to read binary block.");
+        }
+
+        segments.push_back({position, blockSize(header[0], header[1]), offset, header[1], true, false});
+        if (checksummed) {
+            verifier.submit(segments.size() - 1, values.data() + offset, timestamps.data() + offset, header[1],
+                            header[2]);
+        }
+        position += segments.back().byteLength;
+    }
+
+    for (size_t s : verifier.finish()) {
+        segments[s].intact = false;
+        segments[s].checksumFailed = true;
+    }
+    bool allIntact = std::all_of(segments.begin(), segments.end(), [](const Segment& s) { return s.intact; });
+    if (allIntact) {
+        return;
+    }
+
+    // Intact blocks are compacted towards the front; blocks recovered from inside corrupted ranges are
+    // rare and go through a rebuilt copy
+    struct Piece {
+        const double* values;
+        const double* timestamps;
+        size_t count;
+    };
+    std::vector<Piece> pieces;
+    std::vector<RecoveredBlock> recovered;
+    size_t pointIndex = base;
+    for (size_t s = 0; s < segments.size();) {
+        if (segments[s].intact) {
+            pieces.push_back({values.data() + segments[s].columnOffset,
+                              timestamps.data() + segments[s].columnOffset, segments[s].count});
+            pointIndex += segments[s].count;
+            ++s;
+            continue;
+        }
+
+        size_t last = s;
+        bool rescan = false;
+        while (last < segments.size() && !segments[last].intact) {
+            rescan = rescan || segments[last].checksumFailed;
+            ++last;
+        }
+        uint64_t begin = segments[s].byteOffset;
+        uint64_t end = segments[last - 1].byteOffset + segments[last - 1].byteLength;
+
+        std::vector<RecoveredBlock> found = rescan ? recoverBlocks(input, begin + 1, end)
+                                                   : std::vector<RecoveredBlock>();
+        size_t firstFound = recovered.size();
+        for (RecoveredBlock& block : found) {
+            recovered.push_back(std::move(block));
+        }
+        for (size_t r = firstFound; r <= recovered.size(); ++r) {
+            uint64_t gapEnd = r < recovered.size() ? recovered[r].byteOffset : end;
+            if (gapEnd > begin) {
+                corrupted.push_back({begin, gapEnd - begin, pointIndex});
+            }
+            if (r < recovered.size()) {
+                pieces.push_back({recovered[r].values.data(), recovered[r].timestamps.data(),
+                                  recovered[r].values.size()});
+                pointIndex += recovered[r].values.size();
+                begin = recovered[r].byteOffset + recovered[r].byteLength;
+            }
+        }
+        s = last;
+    }
+
+    if (recovered.empty()) {
+        size_t cursor = base;
+        for (const Piece& piece : pieces) {
+            std::memmove(values.data() + cursor, piece.values, piece.count * sizeof(double));
+            std::memmove(timestamps.data() + cursor, piece.timestamps, piece.count * sizeof(double));
+            cursor += piece.count;
+        }
+        values.resize(cursor);
+        timestamps.resize(cursor);
+        return;
+    }
+
+    std::vector<double> rebuiltValues(values.begin(), values.begin() + base);
+    std::vector<double> rebuiltTimestamps(timestamps.begin(), timestamps.begin() + base);
+    rebuiltValues.reserve(pointIndex);
+    rebuiltTimestamps.reserve(pointIndex);
+    for (const Piece& piece : pieces) {
+        rebuiltValues.insert(rebuiltValues.end(), piece.values, piece.values + piece.count);
+        rebuiltTimestamps.insert(rebuiltTimestamps.end(), piece.timestamps, piece.timestamps + piece.count);
+    }
+    values.swap(rebuiltValues);
+    timestamps.swap(rebuiltTimestamps);
+}
+
+void readBuffer(const char* bytes, size_t size, std::vector<double>& values, std::vector<double>& timestamps,
+                bool withHeader) {
+    size_t cursor = 0;
+    if (withHeader) {
+        if (size < kMagicSize || std::memcmp(bytes, kFileMagic, kMagicSize) != 0) {
+            throw IoTDataFileException("Error: Invalid binary file header.");
+        }
+        cursor = kMagicSize;
+    }
+
+    uint32_t header[3];
+    while (cursor < size) {
+        if (size - cursor < 2 * sizeof(uint32_t)) {
+            throw IoTDataFileException("Error: Truncated binary block header.");
+        }
+        std::memcpy(header, bytes + cursor, 2 * sizeof(uint32_t));
+        if ((header[0] != kBlockMagic && header[0] != kChecksumBlockMagic) || header[1] > kMaxBlockPoints) {
+            throw IoTDataFileException("Error: Invalid binary block header.");
+        }
+        if (size - cursor < blockSize(header[0], header[1])) {
+            throw IoTDataFileException("Error: Truncated binary block.");
+        }
+        bool checksummed = header[0] == kChecksumBlockMagic;
+        if (checksummed) {
+            std::memcpy(header + 2, bytes + cursor + 2 * sizeof(uint32_t), sizeof(uint32_t));
+        }
+        cursor += headerSize(header[0]);
+
+        size_t columnBytes = header[1] * sizeof(double);
+        size_t offset = values.size();
+        values.resize(offset + header[1]);
+        timestamps.resize(offset + header[1]);
+        std::memcpy(values.data() + offset, bytes + cursor, columnBytes);
+        std::memcpy(timestamps.data() + offset, bytes + cursor + columnBytes, columnBytes);
+        cursor += 2 * columnBytes;
+
+        if (checksummed && blockChecksum(header[1], values.data() + offset, timestamps.data() + offset) != header[2]) {
+            throw IoTDataFileException("Error: Binary block checksum mismatch.");
+        }
+    }
+}
+
+} // namespace IoTDataBinaryFormat
@@ -0,0 +1,44 @@
+// IoTDataBinaryFormat.h
+// Internal appendable binary series format used by incremental export and import.
+//
+// File:  "IOTBIN01" magic, then any number of blocks.
+// Block: uint32 block magic "IBLC", uint32 point count, uint32 CRC-32C of the count and both columns,
+//        values[count], timestamps[count] (native doubles).
+//        Blocks with the original "IBLK" magic have no checksum field and are still read.
+#ifndef IOT_DATA_BINARY_FORMAT_H
+#define IOT_DATA_BINARY_FORMAT_H
+
+#include "IoTData.h"
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace IoTDataBinaryFormat {
+
+constexpr size_t kMagicSize = 8;
+constexpr size_t kMaxBlockPoints = 64 * 1024;
+
+// True when the file starts with the binary format magic
+bool isBinaryFile(const std::string& filename);
+
+// Writes the file magic (for a new or truncated file)
+void writeHeader(std::ostream& output);
+
+// Appends the points as one or more blocks of at most kMaxBlockPoints
+void writeBlocks(std::ostream& output, const double* values, const double* timestamps, size_t count);
+
+// Reads every intact block of a binary file, appending to the columns. Checksums are verified on a second
+// thread while reading continues. Blocks that fail verification and unreadable bytes are left out and
+// reported in corrupted; checksummed blocks found inside those ranges are still imported.
+void readFile(const std::string& filename, std::vector<double>& values, std::vector<double>& timestamps,
+              std::vector<IoTDataCorruptedRange>& corrupted);
+
+// Parses blocks held in memory (preceded by the file magic when withHeader), appending to the columns.
+// Any checksum mismatch throws.
+void readBuffer(const char* bytes, size_t size, std::vector<double>& values, std::vector<double>& timestamps,
+                bool withHeader = true);
+
+} // namespace IoTDataBinaryFormat
+
+#endif // IOT_DATA_BINARY_FORMAT_H
@@ -0,0 +1,51 @@
+// IoTDataBits.h
+// Internal bit-scan helpers: compiler builtins on GCC and Clang, portable loops elsewhere.
+#ifndef IOT_DATA_BITS_H
+#define IOT_DATA_BITS_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace IoTDataBits {
+
+// Index of the lowest set bit; bits must be non-zero
+inline size_t countTrailingZeros(uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<size_t>(__builtin_ctzll(bits));
+#else
+    size_t count = 0;
+    for (; (bits & 1) == 0; bits >>= 1) {
+        ++count;
+    }
+    return count;
+#endif
+}
+
+// Zero bits above the highest set bit; bits must be non-zero
+inline size_t countLeadingZeros(uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<size_t>(__builtin_clzll(bits));
+#else
+    size_t count = 0;
+    for (; (bits & (uint64_t(1) << 63)) == 0; bits <<= 1) {
+        ++count;
+    }
+    return count;
+#endif
+}
+
+inline size_t popCount(uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<size_t>(__builtin_popcountll(bits));
+#else
+    size_t count = 0;
+    for (; bits != 0; bits &= bits - 1) {
+        ++count;
+    }
+    return count;
+#endif
+}
+
+} // namespace IoTDataBits
+
+#endif // IOT_DATA_BITS_H
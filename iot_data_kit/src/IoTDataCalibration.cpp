@@ -0,0 +1,105 @@
+// IoTDataCalibration.cpp
+#include "IoTDataCalibration.h"
+#include "IoTDataException.h"
+#include "IoTDataSimd.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+IoTDataCalibration IoTDataCalibration::affine(double gain, double offset) {
+    IoTDataCalibration calibration;
+    calibration.kind = CalibrationKind::AFFINE;
+    calibration.coefficients = {offset, gain};
+    return calibration;
+}
+
+IoTDataCalibration IoTDataCalibration::polynomial(const std::vector<double>& coefficients) {
+    if (coefficients.empty()) {
+        throw IoTDataException("Error: Calibration polynomial needs at least one coefficient.");
+    }
+
+    IoTDataCalibration calibration;
+    calibration.kind = CalibrationKind::POLYNOMIAL;
+    calibration.coefficients = coefficients;
+    return calibration;
+}
+
+IoTDataCalibration IoTDataCalibration::lookupTable(const std::vector<double>& raw,
+                                                   const std::vector<double>& calibrated) {
+    if (raw.size() != calibrated.size() || raw.size() < 2) {
+        throw IoTDataException("Error: Calibration table needs at least two matching raw/calibrated points.");
+    }
+    for (size_t i = 1; i < raw.size(); ++i) {
+        if (!(raw[i] > raw[i - 1])) {
+            throw IoTDataException("Error: Calibration table raw points must be strictly increasing.");
+        }
+    }
+
+    IoTDataCalibration calibration;
+    calibration.kind = CalibrationKind::LOOKUP_TABLE;
+    calibration.tableRaw = raw;
+    calibration.tableCalibrated = calibrated;
+
+    // Tables generated on a regular grid (the common case for ADC curves) skip the search
+    double step = (raw.back() - raw.front()) / (raw.size() - 1);
+    double tolerance = 1e-9 * std::max(1.0, std::abs(raw.back()) + std::abs(raw.front()));
+    calibration.uniformTable = true;
+    for (size_t i = 1; i + 1 < raw.size() && calibration.uniformTable; ++i) {
+        calibration.uniformTable = std::abs(raw[i] - (raw.front() + i * step)) <= tolerance;
+    }
+    return calibration;
+}
+
+CalibrationKind IoTDataCalibration::getKind() const {
+    return kind;
+}
+
+double IoTDataCalibration::lookup(double raw) const {
+    if (std::isnan(raw)) {
+        return raw;
+    }
+    if (raw <= tableRaw.front()) {
+        return tableCalibrated.front();
+    }
+    if (raw >= tableRaw.back()) {
+        return tableCalibrated.back();
+    }
+
+    size_t index = std::upper_bound(tableRaw.begin(), tableRaw.end(), raw) - tableRaw.begin();
+    double x0 = tableRaw[index - 1];
+    double y0 = tableCalibrated[index - 1];
+    return y0 + (tableCalibrated[index] - y0) * (raw - x0) / (tableRaw[index] - x0);
+}
+
+double IoTDataCalibration::apply(double raw) const {
+    double calibrated;
+    apply(&raw, &calibrated, 1);
+    return calibrated;
+}
+
+void IoTDataCalibration::apply(const double* raw, double* calibrated, size_t count) const {
+    switch (kind) {
+        case CalibrationKind::IDENTITY:
+            if (raw != calibrated && count > 0) {
+                std::memmove(calibrated, raw, count * sizeof(double));
+            }
+            break;
+
+        case CalibrationKind::AFFINE:
+        case CalibrationKind::POLYNOMIAL:
+            IoTDataSimd::polynomial(raw, count, coefficients.data(), coefficients.size(), calibrated);
+            break;
+
+        case CalibrationKind::LOOKUP_TABLE:
+            if (uniformTable) {
+                double step = (tableRaw.back() - tableRaw.front()) / (tableRaw.size() - 1);
+                IoTDataSimd::uniformLookup(raw, count, tableRaw.front(), step, tableCalibrated.data(),
+                                           tableCalibrated.size(), calibrated);
+            } else {
+                for (size_t i = 0; i < count; ++i) {
+                    calibrated[i] = lookup(raw[i]);
+                }
+            }
+            break;
+    }
+}
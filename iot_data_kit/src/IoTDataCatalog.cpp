@@ -0,0 +1,350 @@
+// IoTDataCatalog.cpp
+#include "IoTDataCatalog.h"
+#include "IoTDataException.h"
+#include "IoTDataSketch.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <set>
+
+namespace {
+
+const char* kManifestFile = "catalog.manifest";
+const char* kBloomFile = "catalog.bloom";
+constexpr char kManifestMagic[4] = {'I', 'C', 'T', '1'};
+constexpr double kBloomFalsePositiveRate = 0.01;
+
+template <typename T>
+void appendValue(std::vector<uint8_t>& buffer, T value) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+void appendString(std::vector<uint8_t>& buffer, const std::string& text) {
+    appendValue(buffer, static_cast<uint32_t>(text.size()));
+    buffer.insert(buffer.end(), text.begin(), text.end());
+}
+
+// Bounds-checked reads of a manifest held in memory
+class ManifestReader {
+private:
+    const std::vector<uint8_t>& bytes;
+    size_t cursor = 0;
+
+    const uint8_t* take(size_t size) {
+        if (bytes.size() - cursor < size) {
+            throw IoTDataFileException("Error: Invalid catalog manifest.");
+        }
+        const uint8_t* position = bytes.data() + cursor;
+        cursor += size;
+        return position;
+    }
+
+public:
+    explicit ManifestReader(const std::vector<uint8_t>& bytes) : bytes(bytes) {}
+
+    template <typename T>
+    T value() {
+        T result;
+        std::memcpy(&result, take(sizeof(T)), sizeof(T));
+        return result;
+    }
+
+    std::string text() {
+        uint32_t size = value<uint32_t>();
+        const uint8_t* position = take(size);
+        return std::string(reinterpret_cast<const char*>(position), size);
+    }
+
+    IoTDataAggregate aggregate() {
+        return IoTDataAggregate::deserialize(take(IoTDataAggregate::kSerializedSize),
+                                             IoTDataAggregate::kSerializedSize);
+    }
+
+    bool done() const {
+        return cursor == bytes.size();
+    }
+};
+
+std::vector<uint8_t> readBytes(const std::string& path) {
+    std::ifstream input(path, std::ios::binary);
+    return std::vector<uint8_t>((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+}
+
+void writeAtomically(const std::string& path, const std::vector<uint8_t>& bytes) {
+    std::string temporary = path + ".tmp";
+    std::ofstream output(temporary, std::ios::binary | std::ios::trunc);
+    if (!output.is_open()) {
+        throw IoTDataFileException("Error: Unable to write the catalog.");
+    }
+    output.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    output.close();
+
+    if (!output || std::rename(temporary.c_str(), path.c_str()) != 0) {
+        throw IoTDataFileException("Error: Unable to write the catalog.");
+    }
+}
+
+int64_t modificationTime(const std::string& path) {
+    return static_cast<int64_t>(std::filesystem::last_write_time(path).time_since_epoch().count());
+}
+
+} // namespace
+
+IoTDataCatalog::IoTDataCatalog(const std::string& directory) : directory(directory) {
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        throw IoTDataFileException("Error: Unable to create the catalog directory.");
+    }
+    load();
+}
+
+std::string IoTDataCatalog::filePath(const std::string& file) const {
+    std::filesystem::path relative(file);
+    if (file.empty() || relative.is_absolute() || file == kManifestFile || file == kBloomFile) {
+        throw IoTDataException("Error: Catalog file '" + file + "' must be a data file path relative to the "
+                               "catalog directory.");
+    }
+    return (std::filesystem::path(directory) / relative).string();
+}
+
+void IoTDataCatalog::load() {
+    std::string path = (std::filesystem::path(directory) / kManifestFile).string();
+    if (!std::filesystem::exists(path)) {
+        return;
+    }
+
+    // Magic, entry count, then per entry: file, sensor id, time range, count, file size and time, aggregate
+    std::vector<uint8_t> bytes = readBytes(path);
+    if (bytes.size() < sizeof(kManifestMagic) || std::memcmp(bytes.data(), kManifestMagic, sizeof(kManifestMagic)) != 0) {
+        throw IoTDataFileException("Error: Invalid catalog manifest.");
+    }
+    ManifestReader reader(bytes);
+    reader.value<uint32_t>();
+    uint64_t entryCount = reader.value<uint64_t>();
+    for (uint64_t i = 0; i < entryCount; ++i) {
+        IoTDataCatalogEntry entry;
+        entry.file = reader.text();
+        entry.sensorId = reader.text();
+        entry.firstTimestamp = reader.value<double>();
+        entry.lastTimestamp = reader.value<double>();
+        entry.count = reader.value<uint64_t>();
+        entry.fileSize = reader.value<uint64_t>();
+        entry.modifiedTime = reader.value<int64_t>();
+        entry.aggregate = reader.aggregate();
+        std::string file = entry.file;
+        entries[file] = std::move(entry);
+    }
+    if (!reader.done()) {
+        throw IoTDataFileException("Error: Invalid catalog manifest.");
+    }
+}
+
+IoTDataCatalogEntry IoTDataCatalog::describe(const std::string& file, const std::string& sensorId,
+                                             const IoTData& series) const {
+    std::string path = filePath(file);
+    IoTDataView view = series.view();
+
+    IoTDataCatalogEntry entry;
+    entry.file = file;
+    entry.sensorId = sensorId;
+    if (entry.sensorId.empty()) {
+        std::string name = std::filesystem::path(file).filename().string();
+        entry.sensorId = name.substr(0, name.find('.'));
+    }
+    if (!view.empty()) {
+        auto range = std::minmax_element(view.timestamps(), view.timestamps() + view.size());
+        entry.firstTimestamp = *range.first;
+        entry.lastTimestamp = *range.second;
+    }
+    entry.count = view.size();
+    entry.aggregate = series.calculateAggregate();
+
+    std::error_code error;
+    entry.fileSize = std::filesystem::file_size(path, error);
+    if (error) {
+        throw IoTDataFileException("Error: Unable to read catalog file '" + file + "'.");
+    }
+    entry.modifiedTime = modificationTime(path);
+    return entry;
+}
+
+const IoTDataCatalogEntry& IoTDataCatalog::addFile(const std::string& file, const std::string& sensorId) {
+    IoTData series(std::vector<double>{});
+    series.importDataFromFile(filePath(file));
+    IoTDataCatalogEntry entry = describe(file, sensorId, series);
+    IoTDataCatalogEntry& stored = entries[file];
+    stored = std::move(entry);
+    return stored;
+}
+
+const IoTDataCatalogEntry& IoTDataCatalog::addSeries(const std::string& file, const std::string& sensorId,
+                                                     const IoTData& series) {
+    IoTDataCatalogEntry entry = describe(file, sensorId, series);
+    IoTDataCatalogEntry& stored = entries[file];
+    stored = std::move(entry);
+    return stored;
+}
+
+bool IoTDataCatalog::removeFile(const std::string& file) {
+    return entries.erase(file) > 0;
+}
+
+size_t IoTDataCatalog::refresh() {
+    size_t changed = 0;
+    for (auto it = entries.begin(); it != entries.end();) {
+        std::string path = filePath(it->first);
+        std::error_code error;
+        uint64_t size = std::filesystem::file_size(path, error);
+        if (error) {
+            it = entries.erase(it);
+            ++changed;
+            continue;
+        }
+
+        if (size != it->second.fileSize || modificationTime(path) != it->second.modifiedTime) {
+            IoTData series(std::vector<double>{});
+            series.importDataFromFile(path);
+            it->second = describe(it->first, it->second.sensorId, series);
+            ++changed;
+        }
+        ++it;
+    }
+    return changed;
+}
+
+void IoTDataCatalog::save() const {
+    std::vector<std::string> sensorIds = getSensorIds();
+    IoTDataBloomFilter filter = IoTDataBloomFilter::fromExpectedCount(sensorIds.size(), kBloomFalsePositiveRate);
+    for (const std::string& sensorId : sensorIds) {
+        filter.add(sensorId);
+    }
+
+    std::vector<uint8_t> manifest(kManifestMagic, kManifestMagic + sizeof(kManifestMagic));
+    appendValue(manifest, static_cast<uint64_t>(entries.size()));
+    for (const auto& item : entries) {
+        const IoTDataCatalogEntry& entry = item.second;
+        appendString(manifest, entry.file);
+        appendString(manifest, entry.sensorId);
+        appendValue(manifest, entry.firstTimestamp);
+        appendValue(manifest, entry.lastTimestamp);
+        appendValue(manifest, entry.count);
+        appendValue(manifest, entry.fileSize);
+        appendValue(manifest, entry.modifiedTime);
+        std::vector<uint8_t> aggregate = entry.aggregate.serialize();
+        manifest.insert(manifest.end(), aggregate.begin(), aggregate.end());
+    }
+
+    // Filter first: after a crash in between it may name extra sensors, but never misses a manifest entry
+    std::filesystem::path root(directory);
+    writeAtomically((root / kBloomFile).string(), filter.serialize());
+    writeAtomically((root / kManifestFile).string(), manifest);
+}
+
+std::vector<IoTDataCatalogEntry> IoTDataCatalog::findFiles(const std::string& sensorId, double start,
+                                                           double end) const {
+    std::vector<IoTDataCatalogEntry> matches;
+    for (const auto& item : entries) {
+        const IoTDataCatalogEntry& entry = item.second;
+        if (entry.sensorId == sensorId && entry.count > 0 && entry.lastTimestamp >= start &&
+            entry.firstTimestamp <= end) {
+            matches.push_back(entry);
+        }
+    }
+    std::sort(matches.begin(), matches.end(), [](const IoTDataCatalogEntry& a, const IoTDataCatalogEntry& b) {
+        return a.firstTimestamp < b.firstTimestamp;
+    });
+    return matches;
+}
+
+IoTData IoTDataCatalog::loadRange(const std::string& sensorId, double start, double end) const {
+    std::vector<double> values;
+    std::vector<double> timestamps;
+    bool ascending = true;
+    for (const IoTDataCatalogEntry& entry : findFiles(sensorId, start, end)) {
+        IoTData part(std::vector<double>{});
+        part.importDataFromFile(filePath(entry.file));
+        IoTDataView view = part.view();
+        for (size_t i = 0; i < view.size(); ++i) {
+            double timestamp = view.timestamp(i);
+            if (timestamp >= start && timestamp <= end) {
+                ascending = ascending && (timestamps.empty() || timestamp >= timestamps.back());
+                timestamps.push_back(timestamp);
+                values.push_back(view.value(i));
+            }
+        }
+    }
+
+    IoTData result(values, timestamps);
+    if (!ascending) {
+        // Files with overlapping time ranges interleave
+        result.sortByTimestamp();
+    }
+    return result;
+}
+
+IoTDataAggregate IoTDataCatalog::aggregateRange(const std::string& sensorId, double start, double end) const {
+    IoTDataAggregate aggregate;
+    for (const auto& item : entries) {
+        const IoTDataCatalogEntry& entry = item.second;
+        if (entry.sensorId == sensorId && entry.count > 0 && entry.lastTimestamp >= start &&
+            entry.firstTimestamp <= end) {
+            aggregate.merge(entry.aggregate);
+        }
+    }
+    return aggregate;
+}
+
+bool IoTDataCatalog::containsSensor(const std::string& sensorId) const {
+    return std::any_of(entries.begin(), entries.end(),
+                       [&sensorId](const auto& item) { return item.second.sensorId == sensorId; });
+}
+
+std::vector<std::string> IoTDataCatalog::getSensorIds() const {
+    std::set<std::string> sensorIds;
+    for (const auto& item : entries) {
+        sensorIds.insert(item.second.sensorId);
+    }
+    return std::vector<std::string>(sensorIds.begin(), sensorIds.end());
+}
+
+const std::map<std::string, IoTDataCatalogEntry>& IoTDataCatalog::getEntries() const {
+    return entries;
+}
+
+const std::string& IoTDataCatalog::getDirectory() const {
+    return directory;
+}
+
+std::vector<std::string> IoTDataCatalog::candidateDirectories(const std::string& root, const std::string& sensorId) {
+    std::vector<std::string> directories;
+    auto check = [&](const std::filesystem::path& candidate) {
+        std::filesystem::path bloomPath = candidate / kBloomFile;
+        std::error_code error;
+        if (!std::filesystem::is_regular_file(bloomPath, error)) {
+            return;
+        }
+        std::vector<uint8_t> bytes = readBytes(bloomPath.string());
+        if (IoTDataBloomFilter::deserialize(bytes.data(), bytes.size()).mightContain(sensorId)) {
+            directories.push_back(candidate.string());
+        }
+    };
+
+    std::error_code error;
+    if (!std::filesystem::is_directory(root, error)) {
+        throw IoTDataFileException("Error: Catalog root '" + root + "' is not a directory.");
+    }
+    check(root);
+    std::filesystem::recursive_directory_iterator it(root, std::filesystem::directory_options::skip_permission_denied,
+                                                     error);
+    for (; !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error)) {
+        if (it->is_directory(error)) {
+            check(it->path());
+        }
+    }
+    return directories;
+}
@@ -0,0 +1,176 @@
+// IoTDataChecksum.cpp
+#include "IoTDataChecksum.h"
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define IOT_DATA_CHECKSUM_X86 1
+#include <immintrin.h>
+#endif
+
+namespace IoTDataChecksum {
+
+namespace {
+
+constexpr uint32_t kPolynomial = 0x82F63B78;  // Castagnoli, bit-reflected
+
+// Slicing-by-8 tables for the portable path
+struct Tables {
+    uint32_t slice[8][256];
+};
+
+const Tables& tables() {
+    static const Tables instance = [] {
+        Tables t{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = crc & 1 ? (crc >> 1) ^ kPolynomial : crc >> 1;
+            }
+            t.slice[0][i] = crc;
+        }
+        for (uint32_t i = 0; i < 256; ++i) {
+            for (int k = 1; k < 8; ++k) {
+                t.slice[k][i] = (t.slice[k - 1][i] >> 8) ^ t.slice[0][t.slice[k - 1][i] & 0xFF];
+            }
+        }
+        return t;
+    }();
+    return instance;
+}
+
+// Words are loaded little-endian, like the native doubles of the binary format
+uint32_t updateScalar(uint32_t state, const uint8_t* bytes, size_t size) {
+    const auto& t = tables().slice;
+    while (size >= 8) {
+        uint64_t word;
+        std::memcpy(&word, bytes, sizeof(word));
+        word ^= state;
+        state = t[7][word & 0xFF] ^ t[6][(word >> 8) & 0xFF] ^ t[5][(word >> 16) & 0xFF] ^
+                t[4][(word >> 24) & 0xFF] ^ t[3][(word >> 32) & 0xFF] ^ t[2][(word >> 40) & 0xFF] ^
+                t[1][(word >> 48) & 0xFF] ^ t[0][word >> 56];
+        bytes += 8;
+        size -= 8;
+    }
+    while (size-- > 0) {
+        state = (state >> 8) ^ t[0][(state ^ *bytes++) & 0xFF];
+    }
+    return state;
+}
+
+#ifdef IOT_DATA_CHECKSUM_X86
+// Bytes per stream when three streams are interleaved to hide the latency of the CRC instruction
+constexpr size_t kLaneBytes = 4096;
+
+// a * b modulo the polynomial, both bit-reflected (bit 31 is x^0)
+uint32_t multiplyModP(uint32_t a, uint32_t b) {
+    uint32_t product = 0;
+    for (uint32_t m = 1u << 31; m != 0; m >>= 1) {
+        if (a & m) {
+            product ^= b;
+        }
+        b = b & 1 ? (b >> 1) ^ kPolynomial : b >> 1;
+    }
+    return product;
+}
+
+// x^n modulo the polynomial, bit-reflected
+uint32_t powerOfX(uint64_t n) {
+    uint32_t result = 1u << 31;
+    uint32_t square = 1u << 30;
+    while (n != 0) {
+        if (n & 1) {
+            result = multiplyModP(result, square);
+        }
+        square = multiplyModP(square, square);
+        n >>= 1;
+    }
+    return result;
+}
+
+__attribute__((target("sse4.2"))) uint32_t updateSse42(uint32_t state, const uint8_t* bytes, size_t size) {
+    uint64_t crc = state;
+    while (size >= 8) {
+        uint64_t word;
+        std::memcpy(&word, bytes, sizeof(word));
+        crc = _mm_crc32_u64(crc, word);
+        bytes += 8;
+        size -= 8;
+    }
+    state = static_cast<uint32_t>(crc);
+    while (size-- > 0) {
+        state = _mm_crc32_u8(state, *bytes++);
+    }
+    return state;
+}
+
+// state advanced over kLaneBytes zero bytes: state * x^(8 * kLaneBytes). The carry-less product is one
+// bit short of a reflected 64-bit value and the CRC instruction multiplies by x^32, hence x^(8n - 33).
+__attribute__((target("sse4.2,pclmul"))) uint32_t shiftLane(uint32_t state) {
+    static const uint32_t laneShift = powerOfX(8 * kLaneBytes - 33);
+    __m128i product = _mm_clmulepi64_si128(_mm_cvtsi32_si128(static_cast<int>(state)),
+                                           _mm_cvtsi32_si128(static_cast<int>(laneShift)), 0);
+    return static_cast<uint32_t>(_mm_crc32_u64(0, static_cast<uint64_t>(_mm_cvtsi128_si64(product))));
+}
+
+// Three independent streams keep the CRC unit busy; their results are combined by shifting
+__attribute__((target("sse4.2,pclmul"))) uint32_t updateInterleaved(uint32_t state, const uint8_t* bytes,
+                                                                     size_t size) {
+    while (size >= 3 * kLaneBytes) {
+        uint64_t a = state;
+        uint64_t b = 0;
+        uint64_t c = 0;
+        for (size_t i = 0; i < kLaneBytes; i += 8) {
+            uint64_t wordA;
+            uint64_t wordB;
+            uint64_t wordC;
+            std::memcpy(&wordA, bytes + i, sizeof(wordA));
+            std::memcpy(&wordB, bytes + kLaneBytes + i, sizeof(wordB));
+            std::memcpy(&wordC, bytes + 2 * kLaneBytes + i, sizeof(wordC));
+            a = _mm_crc32_u64(a, wordA);
+            b = _mm_crc32_u64(b, wordB);
+            c = _mm_crc32_u64(c, wordC);
+        }
+        state = shiftLane(static_cast<uint32_t>(a)) ^ static_cast<uint32_t>(b);
+        state = shiftLane(state) ^ static_cast<uint32_t>(c);
+        bytes += 3 * kLaneBytes;
+        size -= 3 * kLaneBytes;
+    }
+    return updateSse42(state, bytes, size);
+}
+#endif
+
+} // namespace
+
+bool hasSse42() {
+#ifdef IOT_DATA_CHECKSUM_X86
+    static const bool supported = __builtin_cpu_supports("sse4.2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+bool hasPclmul() {
+#ifdef IOT_DATA_CHECKSUM_X86
+    static const bool supported = __builtin_cpu_supports("pclmul");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+uint32_t crc32c(const void* data, size_t size, uint32_t crc) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint32_t state = ~crc;
+#ifdef IOT_DATA_CHECKSUM_X86
+    if (hasSse42() && hasPclmul()) {
+        return ~updateInterleaved(state, bytes, size);
+    }
+    if (hasSse42()) {
+        return ~updateSse42(state, bytes, size);
+    }
+#endif
+    return ~updateScalar(state, bytes, size);
+}
+
+} // namespace IoTDataChecksum
@@ -0,0 +1,22 @@
+// IoTDataChecksum.h
+// Internal CRC-32C (Castagnoli) with runtime dispatch between SSE4.2/PCLMUL and portable code.
+#ifndef IOT_DATA_CHECKSUM_H
+#define IOT_DATA_CHECKSUM_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace IoTDataChecksum {
+
+// True when the running CPU has the SSE4.2 CRC-32C instruction
+bool hasSse42();
+
+// True when the running CPU has carry-less multiplication (used to combine interleaved CRC streams)
+bool hasPclmul();
+
+// CRC-32C of size bytes. Pass a previous result as crc to continue it over further bytes.
+uint32_t crc32c(const void* data, size_t size, uint32_t crc = 0);
+
+} // namespace IoTDataChecksum
+
+#endif // IOT_DATA_CHECKSUM_H
@@ -0,0 +1,346 @@
+// IoTDataCompactSeries.cpp
+#include "IoTDataCompactSeries.h"
+#include "IoTDataBits.h"
+#include "IoTDataException.h"
+#include "IoTDataSimd.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+constexpr size_t kBlockSize = IoTDataTimestampColumn::kBlockSize;
+constexpr double kTickScales[] = {1.0, 1e3, 1e6, 1e9};
+constexpr double kMaximumTick = 1125899906842624.0;  // 2^50 keeps every prefix sum exact in the SIMD decode
+constexpr uint32_t kMaximumBitWidth = 56;
+constexpr uint32_t kRawBitWidth = 64;
+
+// Bit fields may straddle two words; the second word is only touched when they do
+void writeBits(uint64_t* words, size_t position, uint32_t width, uint64_t value) {
+    size_t word = position / 64;
+    uint32_t shift = static_cast<uint32_t>(position % 64);
+    words[word] |= value << shift;
+    if (shift + width > 64) {
+        words[word + 1] |= value >> (64 - shift);
+    }
+}
+
+uint64_t readBits(const uint64_t* words, size_t position, uint32_t width) {
+    size_t word = position / 64;
+    uint32_t shift = static_cast<uint32_t>(position % 64);
+    uint64_t value = words[word] >> shift;
+    if (shift + width > 64) {
+        value |= words[word + 1] << (64 - shift);
+    }
+    return value & ((uint64_t(1) << width) - 1);
+}
+
+// Integer ticks reproducing every timestamp exactly at scale, or false
+bool toTicks(const double* timestamps, size_t count, double scale, int64_t* ticks) {
+    for (size_t i = 0; i < count; ++i) {
+        double scaled = timestamps[i] * scale;
+        if (!(std::fabs(scaled) < kMaximumTick)) {
+            return false;
+        }
+        ticks[i] = std::llround(scaled);
+        if (static_cast<double>(ticks[i]) / scale != timestamps[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+IoTDataTimestampColumn::IoTDataTimestampColumn(const double* timestamps, size_t count) {
+    size_t full = count - count % kBlockSize;
+    blocks.reserve(full / kBlockSize);
+    for (size_t i = 0; i < full; i += kBlockSize) {
+        encodeBlock(timestamps + i, kBlockSize);
+    }
+    tail.assign(timestamps + full, timestamps + count);
+    rowCount = count;
+
+    // packed grew block by block; drop the spare capacity so memoryUsage reports the encoded size
+    packed.shrink_to_fit();
+}
+
+void IoTDataTimestampColumn::encodeBlock(const double* timestamps, size_t count) {
+    Block block{timestamps[0], timestamps[count - 1], 0.0, 0, 0, packed.size(), static_cast<uint32_t>(count),
+                kRawBitWidth};
+
+    // Coarsest exact resolution first, since it gives the narrowest deltas
+    int64_t ticks[kBlockSize] = {};
+    for (double scale : kTickScales) {
+        if (!toTicks(timestamps, count, scale, ticks)) {
+            continue;
+        }
+        int64_t minimum = 0;
+        int64_t maximum = 0;
+        for (size_t i = 1; i < count; ++i) {
+            int64_t delta = ticks[i] - ticks[i - 1];
+            minimum = i == 1 || delta < minimum ? delta : minimum;
+            maximum = i == 1 || delta > maximum ? delta : maximum;
+        }
+        uint64_t range = static_cast<uint64_t>(maximum - minimum);
+        uint32_t width = range == 0 ? 0 : static_cast<uint32_t>(64 - IoTDataBits::countLeadingZeros(range));
+        if (width > kMaximumBitWidth) {
+            break;
+        }
+
+        block.scale = scale;
+        block.base = ticks[0];
+        block.minimumDelta = minimum;
+        block.bitWidth = width;
+        packed.resize(packed.size() + ((count - 1) * width + 63) / 64, 0);
+        for (size_t i = 1; i < count && width > 0; ++i) {
+            writeBits(packed.data() + block.offset, (i - 1) * width,
+                      width, static_cast<uint64_t>(ticks[i] - ticks[i - 1] - minimum));
+        }
+        blocks.push_back(block);
+        return;
+    }
+
+    packed.resize(packed.size() + count);
+    std::memcpy(packed.data() + block.offset, timestamps, count * sizeof(double));
+    blocks.push_back(block);
+}
+
+void IoTDataTimestampColumn::append(double timestamp) {
+    tail.push_back(timestamp);
+    ++rowCount;
+    if (tail.size() == kBlockSize) {
+        encodeBlock(tail.data(), kBlockSize);
+        tail.clear();
+    }
+}
+
+void IoTDataTimestampColumn::clear() {
+    blocks.clear();
+    packed.clear();
+    tail.clear();
+    rowCount = 0;
+}
+
+size_t IoTDataTimestampColumn::size() const {
+    return rowCount;
+}
+
+bool IoTDataTimestampColumn::empty() const {
+    return rowCount == 0;
+}
+
+double IoTDataTimestampColumn::at(size_t index) const {
+    if (index >= rowCount) {
+        throw IoTDataException("Error: Timestamp index out of range.");
+    }
+
+    size_t b = index / kBlockSize;
+    size_t offset = index % kBlockSize;
+    if (b == blocks.size()) {
+        return tail[offset];
+    }
+
+    const Block& block = blocks[b];
+    if (block.bitWidth == kRawBitWidth) {
+        double value;
+        std::memcpy(&value, &packed[block.offset + offset], sizeof(value));
+        return value;
+    }
+    int64_t tick = block.base + static_cast<int64_t>(offset) * block.minimumDelta;
+    for (size_t i = 0; i < offset && block.bitWidth > 0; ++i) {
+        tick += static_cast<int64_t>(readBits(packed.data() + block.offset, i * block.bitWidth, block.bitWidth));
+    }
+    return static_cast<double>(tick) / block.scale;
+}
+
+size_t IoTDataTimestampColumn::getBlockCount() const {
+    return blocks.size() + (tail.empty() ? 0 : 1);
+}
+
+size_t IoTDataTimestampColumn::decodeBlock(size_t b, double* output) const {
+    if (b == blocks.size()) {
+        std::copy(tail.begin(), tail.end(), output);
+        return tail.size();
+    }
+    if (b > blocks.size()) {
+        throw IoTDataException("Error: Timestamp block index out of range.");
+    }
+
+    const Block& block = blocks[b];
+    if (block.bitWidth == kRawBitWidth) {
+        std::memcpy(output, packed.data() + block.offset, block.count * sizeof(double));
+        return block.count;
+    }
+
+    // Unpack deltas, then let the SIMD scan rebuild ticks and convert them in one pass
+    int64_t ticks[kBlockSize];
+    ticks[0] = block.base;
+    const uint64_t* words = packed.data() + block.offset;
+    for (size_t i = 1; i < block.count; ++i) {
+        uint64_t bits = block.bitWidth > 0 ? readBits(words, (i - 1) * block.bitWidth, block.bitWidth) : 0;
+        ticks[i] = static_cast<int64_t>(bits) + block.minimumDelta;
+    }
+    IoTDataSimd::prefixSumTicks(ticks, block.count, block.scale, output);
+    return block.count;
+}
+
+std::vector<double> IoTDataTimestampColumn::decode() const {
+    std::vector<double> result(rowCount);
+    for (size_t b = 0; b < getBlockCount(); ++b) {
+        decodeBlock(b, result.data() + b * kBlockSize);
+    }
+    return result;
+}
+
+size_t IoTDataTimestampColumn::lowerBoundBlock(double timestamp) const {
+    auto it = std::partition_point(blocks.begin(), blocks.end(),
+                                   [timestamp](const Block& block) { return block.last < timestamp; });
+    size_t b = static_cast<size_t>(it - blocks.begin());
+    if (b == blocks.size() && (tail.empty() || tail.back() < timestamp)) {
+        return getBlockCount();
+    }
+    return b;
+}
+
+size_t IoTDataTimestampColumn::lowerBound(double timestamp) const {
+    size_t b = lowerBoundBlock(timestamp);
+    if (b == getBlockCount()) {
+        return rowCount;
+    }
+    if (b < blocks.size() && blocks[b].first >= timestamp) {
+        return b * kBlockSize;
+    }
+
+    double decoded[kBlockSize];
+    size_t count = decodeBlock(b, decoded);
+    return b * kBlockSize + static_cast<size_t>(std::lower_bound(decoded, decoded + count, timestamp) - decoded);
+}
+
+size_t IoTDataTimestampColumn::memoryUsage() const {
+    return blocks.capacity() * sizeof(Block) + packed.capacity() * sizeof(uint64_t) +
+           tail.capacity() * sizeof(double);
+}
+
+namespace {
+
+// The two most recently decoded blocks, enough for the neighbours of any lower bound
+class BlockCache {
+private:
+    const IoTDataTimestampColumn& column;
+    size_t blockIds[2] = {SIZE_MAX, SIZE_MAX};
+    size_t counts[2] = {0, 0};
+    double values[2][kBlockSize];
+    size_t next = 0;
+
+public:
+    explicit BlockCache(const IoTDataTimestampColumn& column) : column(column) {}
+
+    const double* load(size_t block, size_t& count) {
+        for (size_t slot = 0; slot < 2; ++slot) {
+            if (blockIds[slot] == block) {
+                count = counts[slot];
+                return values[slot];
+            }
+        }
+        size_t slot = next;
+        next ^= 1;
+        blockIds[slot] = block;
+        counts[slot] = column.decodeBlock(block, values[slot]);
+        count = counts[slot];
+        return values[slot];
+    }
+
+    double at(size_t index) {
+        size_t count;
+        return load(index / kBlockSize, count)[index % kBlockSize];
+    }
+};
+
+} // namespace
+
+IoTDataCompactSeries::IoTDataCompactSeries(const IoTData& series) {
+    IoTDataView view = series.view();
+    data.assign(view.values(), view.values() + view.size());
+    timestamps = IoTDataTimestampColumn(view.timestamps(), view.size());
+}
+
+void IoTDataCompactSeries::appendData(double newData, double timestamp) {
+    data.push_back(newData);
+    timestamps.append(timestamp);
+}
+
+void IoTDataCompactSeries::clearData() {
+    data.clear();
+    timestamps.clear();
+}
+
+size_t IoTDataCompactSeries::getDataSize() const {
+    return data.size();
+}
+
+double IoTDataCompactSeries::getValue(size_t index) const {
+    if (index >= data.size()) {
+        throw IoTDataException("Error: Data index out of range.");
+    }
+    return data[index];
+}
+
+double IoTDataCompactSeries::getTimestamp(size_t index) const {
+    return timestamps.at(index);
+}
+
+const IoTDataTimestampColumn& IoTDataCompactSeries::getTimestamps() const {
+    return timestamps;
+}
+
+std::vector<double> IoTDataCompactSeries::interpolateData(const std::vector<double>& newTimestamps,
+                                                          InterpolationMethod method) const {
+    if (data.empty()) {
+        throw IoTDataEmptyException("Error: No data available for interpolation.");
+    }
+    if (method == InterpolationMethod::CUBIC_SPLINE) {
+        // The spline system spans every point, so the column is decoded once
+        return toIoTData().interpolateData(newTimestamps, method);
+    }
+
+    std::vector<double> interpolatedData;
+    interpolatedData.reserve(newTimestamps.size());
+    BlockCache cache(timestamps);
+    size_t blockCount = timestamps.getBlockCount();
+
+    for (double t : newTimestamps) {
+        size_t index = data.size();
+        size_t block = timestamps.lowerBoundBlock(t);
+        if (block < blockCount) {
+            size_t count;
+            const double* decoded = cache.load(block, count);
+            index = block * kBlockSize + static_cast<size_t>(std::lower_bound(decoded, decoded + count, t) - decoded);
+        }
+
+        if (index == 0) {
+            interpolatedData.push_back(data.front());
+        } else if (index == data.size()) {
+            interpolatedData.push_back(data.back());
+        } else {
+            double t1 = cache.at(index);
+            double t0 = cache.at(index - 1);
+            if (method == InterpolationMethod::LINEAR) {
+                double y0 = data[index - 1];
+                double y1 = data[index];
+                interpolatedData.push_back(y0 + (y1 - y0) * (t - t0) / (t1 - t0));
+            } else {
+                interpolatedData.push_back(std::abs(t - t0) < std::abs(t - t1) ? data[index - 1] : data[index]);
+            }
+        }
+    }
+    return interpolatedData;
+}
+
+IoTData IoTDataCompactSeries::toIoTData() const {
+    return IoTData(data, timestamps.decode());
+}
+
+size_t IoTDataCompactSeries::memoryUsage() const {
+    return data.capacity() * sizeof(double) + timestamps.memoryUsage();
+}
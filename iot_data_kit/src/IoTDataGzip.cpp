@@ -0,0 +1,540 @@
+// IoTDataGzip.cpp
+#include "IoTDataGzip.h"
+#include "IoTDataBinaryFormat.h"
+#include "IoTDataException.h"
+#include "IoTDataSort.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#ifdef IOTDATAKIT_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace IoTDataGzip {
+
+namespace {
+
+constexpr unsigned char kGzipMagic[2] = {0x1F, 0x8B};
+
+// Calls f(index) for every index in [0, count), handing indices out one at a time across threads
+template <typename F>
+void forEachIndex(size_t count, size_t threadCount, F f) {
+    threadCount = std::min(threadCount, count);
+    std::atomic<size_t> next(0);
+    std::exception_ptr firstError;
+    std::mutex errorMutex;
+    auto worker = [&]() {
+        for (size_t i = next++; i < count; i = next++) {
+            try {
+                f(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!firstError) {
+                    firstError = std::current_exception();
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t t = 1; t < threadCount; ++t) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+
+    if (firstError) {
+        std::rethrow_exception(firstError);
+    }
+}
+
+const char* skipSpace(const char* cursor, const char* end) {
+    while (cursor < end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\n' || *cursor == '\r' ||
+                            *cursor == '\v' || *cursor == '\f')) {
+        ++cursor;
+    }
+    return cursor;
+}
+
+// "timestamp,value" records as read by the plain-text importer. Returns false when parsing stopped at a
+// token that is not a number (the importer ends there without an error). The text must end in whitespace
+// or be NUL-terminated so strtod cannot run past end.
+bool parseCsv(const char* cursor, const char* end, std::vector<double>& values, std::vector<double>& timestamps) {
+    while (true) {
+        cursor = skipSpace(cursor, end);
+        if (cursor == end) {
+            return true;
+        }
+        char* next;
+        double timestamp = std::strtod(cursor, &next);
+        if (next == cursor) {
+            return false;
+        }
+        cursor = skipSpace(next, end);
+        if (cursor == end) {
+            return false;
+        }
+        if (*cursor != ',') {
+            throw IoTDataFileException("Error: Invalid file format. Expected comma-separated values.");
+        }
+        cursor = skipSpace(cursor + 1, end);
+        if (cursor == end) {
+            return false;
+        }
+        double value = std::strtod(cursor, &next);
+        if (next == cursor) {
+            return false;
+        }
+        cursor = next;
+        timestamps.push_back(timestamp);
+        values.push_back(value);
+    }
+}
+
+bool isBinaryPayload(const std::string& bytes) {
+    std::vector<double> unused;
+    try {
+        IoTDataBinaryFormat::readBuffer(bytes.data(), std::min(bytes.size(), IoTDataBinaryFormat::kMagicSize),
+                                        unused, unused);
+        return true;
+    } catch (const IoTDataFileException&) {
+        return false;
+    }
+}
+
+std::string memberPayload(const double* values, const double* timestamps, size_t count, ExportFormat format,
+                          size_t member) {
+    size_t begin = member * kMemberPoints;
+    size_t end = std::min(count, begin + kMemberPoints);
+    if (format == ExportFormat::BINARY) {
+        std::ostringstream output;
+        if (member == 0) {
+            IoTDataBinaryFormat::writeHeader(output);
+        }
+        IoTDataBinaryFormat::writeBlocks(output, values + begin, timestamps + begin, end - begin);
+        return output.str();
+    }
+
+    // %g matches the default ostream formatting used by the plain CSV export
+    std::string text;
+    text.reserve((end - begin) * 24);
+    char line[64];
+    for (size_t i = begin; i < end; ++i) {
+        int length = std::snprintf(line, sizeof(line), "%g,%g\n", timestamps[i], values[i]);
+        text.append(line, static_cast<size_t>(length));
+    }
+    return text;
+}
+
+#ifdef IOTDATAKIT_HAVE_ZLIB
+
+constexpr size_t kMemberHeaderSize = 24;   // Fixed gzip header, XLEN and the 12-byte "IK" subfield
+constexpr size_t kMemberTrailerSize = 8;   // CRC-32 and uncompressed size
+constexpr size_t kStreamChunkSize = 1 << 20;
+constexpr size_t kQueueDepth = 4;
+
+[[noreturn]] void corrupted() {
+    throw IoTDataFileException("Error: Invalid or corrupted compressed file.");
+}
+
+void putLittleEndian32(unsigned char* out, uint32_t value) {
+    out[0] = static_cast<unsigned char>(value);
+    out[1] = static_cast<unsigned char>(value >> 8);
+    out[2] = static_cast<unsigned char>(value >> 16);
+    out[3] = static_cast<unsigned char>(value >> 24);
+}
+
+uint32_t getLittleEndian32(const unsigned char* in) {
+    return static_cast<uint32_t>(in[0]) | static_cast<uint32_t>(in[1]) << 8 | static_cast<uint32_t>(in[2]) << 16 |
+           static_cast<uint32_t>(in[3]) << 24;
+}
+
+std::string compressMember(const std::string& payload, int level) {
+    z_stream stream{};
+    if (deflateInit2(&stream, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        throw IoTDataFileException("Error: Unable to initialise gzip compression.");
+    }
+
+    std::string member(kMemberHeaderSize + deflateBound(&stream, payload.size()) + kMemberTrailerSize, '\0');
+    unsigned char* bytes = reinterpret_cast<unsigned char*>(&member[0]);
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(payload.data()));
+    stream.avail_in = static_cast<uInt>(payload.size());
+    stream.next_out = bytes + kMemberHeaderSize;
+    stream.avail_out = static_cast<uInt>(member.size() - kMemberHeaderSize - kMemberTrailerSize);
+    int status = deflate(&stream, Z_FINISH);
+    size_t compressedSize = stream.total_out;
+    deflateEnd(&stream);
+    if (status != Z_STREAM_END) {
+        throw IoTDataFileException("Error: Unable to compress the export data.");
+    }
+
+    size_t memberSize = kMemberHeaderSize + compressedSize + kMemberTrailerSize;
+    const unsigned char header[16] = {0x1F, 0x8B, 8, 4, 0, 0, 0, 0, 0, 255, 12, 0, 'I', 'K', 8, 0};
+    std::memcpy(bytes, header, sizeof(header));
+    putLittleEndian32(bytes + 16, static_cast<uint32_t>(memberSize));
+    putLittleEndian32(bytes + 20, static_cast<uint32_t>(payload.size()));
+    unsigned char* trailer = bytes + kMemberHeaderSize + compressedSize;
+    uLong checksum = crc32(0L, reinterpret_cast<const Bytef*>(payload.data()), static_cast<uInt>(payload.size()));
+    putLittleEndian32(trailer, static_cast<uint32_t>(checksum));
+    putLittleEndian32(trailer + 4, static_cast<uint32_t>(payload.size()));
+    member.resize(memberSize);
+    return member;
+}
+
+struct MemberLocation {
+    size_t offset;
+    size_t size;
+    size_t uncompressedSize;
+};
+
+// Whether kMemberHeaderSize bytes start a member carrying the "IK" subfield (the OS byte is not checked)
+bool isMemberHeader(const unsigned char* header) {
+    const unsigned char expected[16] = {0x1F, 0x8B, 8, 4, 0, 0, 0, 0, 0, 0, 12, 0, 'I', 'K', 8, 0};
+    return std::memcmp(header, expected, 8) == 0 && std::memcmp(header + 10, expected + 10, 6) == 0;
+}
+
+// Member boundaries from the "IK" header fields; empty when the file was not written in that layout
+std::vector<MemberLocation> locateMembers(const std::vector<unsigned char>& file) {
+    std::vector<MemberLocation> members;
+    size_t offset = 0;
+    while (offset < file.size()) {
+        const unsigned char* header = file.data() + offset;
+        if (file.size() - offset < kMemberHeaderSize + kMemberTrailerSize || !isMemberHeader(header)) {
+            return {};
+        }
+        size_t size = getLittleEndian32(header + 16);
+        if (size < kMemberHeaderSize + kMemberTrailerSize || size > file.size() - offset) {
+            return {};
+        }
+        members.push_back({offset, size, getLittleEndian32(header + 20)});
+        offset += size;
+    }
+    return members;
+}
+
+std::string inflateMember(const std::vector<unsigned char>& file, const MemberLocation& member) {
+    std::string payload(member.uncompressedSize, '\0');
+    z_stream stream{};
+    if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+        throw IoTDataFileException("Error: Unable to initialise gzip decompression.");
+    }
+    stream.next_in = const_cast<Bytef*>(file.data() + member.offset + kMemberHeaderSize);
+    stream.avail_in = static_cast<uInt>(member.size - kMemberHeaderSize - kMemberTrailerSize);
+    stream.next_out = reinterpret_cast<Bytef*>(&payload[0]);
+    stream.avail_out = static_cast<uInt>(payload.size());
+    int status = inflate(&stream, Z_FINISH);
+    size_t produced = stream.total_out;
+    inflateEnd(&stream);
+
+    const unsigned char* trailer = file.data() + member.offset + member.size - kMemberTrailerSize;
+    uLong checksum = crc32(0L, reinterpret_cast<const Bytef*>(payload.data()), static_cast<uInt>(payload.size()));
+    if (status != Z_STREAM_END || produced != payload.size() || getLittleEndian32(trailer) != checksum ||
+        getLittleEndian32(trailer + 4) != static_cast<uint32_t>(payload.size())) {
+        corrupted();
+    }
+    return payload;
+}
+
+// Members are inflated and parsed concurrently into per-member columns, then concatenated in order
+void readMembers(const std::vector<unsigned char>& file, const std::vector<MemberLocation>& members,
+                 std::vector<double>& values, std::vector<double>& timestamps, size_t threadCount) {
+    struct Parsed {
+        std::vector<double> values;
+        std::vector<double> timestamps;
+        bool complete = true;
+    };
+    std::vector<Parsed> parsed(members.size());
+
+    std::string first = inflateMember(file, members[0]);
+    bool binary = isBinaryPayload(first);
+    auto parse = [&](size_t index, const std::string& payload) {
+        Parsed& result = parsed[index];
+        if (binary) {
+            IoTDataBinaryFormat::readBuffer(payload.data(), payload.size(), result.values, result.timestamps,
+                                            index == 0);
+        } else {
+            result.complete = parseCsv(payload.data(), payload.data() + payload.size(), result.values,
+                                       result.timestamps);
+        }
+    };
+    parse(0, first);
+    first = std::string();
+
+    if (threadCount == 0) {
+        threadCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+    forEachIndex(members.size() - 1, threadCount, [&](size_t i) { parse(i + 1, inflateMember(file, members[i + 1])); });
+
+    // A CSV member that stopped early ends the import, as the plain-text importer would
+    size_t total = 0;
+    size_t used = 0;
+    while (used < parsed.size()) {
+        total += parsed[used].values.size();
+        if (!parsed[used++].complete) {
+            break;
+        }
+    }
+    values.reserve(values.size() + total);
+    timestamps.reserve(timestamps.size() + total);
+    for (size_t i = 0; i < used; ++i) {
+        values.insert(values.end(), parsed[i].values.begin(), parsed[i].values.end());
+        timestamps.insert(timestamps.end(), parsed[i].timestamps.begin(), parsed[i].timestamps.end());
+    }
+}
+
+// Bounded hand-off of inflated chunks from the background inflater to the parsing thread
+struct ChunkQueue {
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<std::string> chunks;
+    bool finished = false;
+    bool cancelled = false;
+    std::exception_ptr error;
+
+    bool push(std::string chunk) {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [this] { return cancelled || chunks.size() < kQueueDepth; });
+        if (cancelled) {
+            return false;
+        }
+        chunks.push_back(std::move(chunk));
+        changed.notify_all();
+        return true;
+    }
+
+    // False once the inflater has finished and every chunk has been taken
+    bool pop(std::string& chunk) {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [this] { return finished || !chunks.empty(); });
+        if (chunks.empty()) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+            return false;
+        }
+        chunk = std::move(chunks.front());
+        chunks.pop_front();
+        changed.notify_all();
+        return true;
+    }
+
+    void finish(std::exception_ptr failure) {
+        std::lock_guard<std::mutex> lock(mutex);
+        error = failure;
+        finished = true;
+        changed.notify_all();
+    }
+
+    void cancel() {
+        std::lock_guard<std::mutex> lock(mutex);
+        cancelled = true;
+        changed.notify_all();
+    }
+};
+
+// Inflates any gzip file (one or more members) into queue chunks of kStreamChunkSize bytes
+void inflateStream(std::ifstream& input, ChunkQueue& queue) {
+    z_stream stream{};
+    if (inflateInit2(&stream, MAX_WBITS + 16) != Z_OK) {
+        throw IoTDataFileException("Error: Unable to initialise gzip decompression.");
+    }
+    struct StreamGuard {
+        z_stream& stream;
+        ~StreamGuard() { inflateEnd(&stream); }
+    } guard{stream};
+
+    std::vector<char> in(kStreamChunkSize);
+    std::string out(kStreamChunkSize, '\0');
+    bool inMember = false;
+    while (true) {
+        if (stream.avail_in == 0) {
+            input.read(in.data(), static_cast<std::streamsize>(in.size()));
+            stream.next_in = reinterpret_cast<Bytef*>(in.data());
+            stream.avail_in = static_cast<uInt>(input.gcount());
+            if (stream.avail_in == 0) {
+                break;
+            }
+        }
+
+        inMember = true;
+        stream.next_out = reinterpret_cast<Bytef*>(&out[0]);
+        stream.avail_out = static_cast<uInt>(out.size());
+        int status = inflate(&stream, Z_NO_FLUSH);
+        if (status == Z_STREAM_END) {
+            inMember = false;
+            inflateReset(&stream);
+        } else if (status != Z_OK && status != Z_BUF_ERROR) {
+            corrupted();
+        }
+
+        size_t produced = out.size() - stream.avail_out;
+        if (produced > 0) {
+            std::string chunk(out.data(), produced);
+            if (!queue.push(std::move(chunk))) {
+                return;
+            }
+        }
+    }
+
+    if (inMember) {
+        corrupted();
+    }
+}
+
+// Any other gzip file: a background thread inflates while this thread parses
+void readStream(const std::string& filename, std::vector<double>& values, std::vector<double>& timestamps) {
+    std::ifstream input(filename, std::ios::binary);
+    if (!input.is_open()) {
+        throw IoTDataFileException("Error: Unable to open the file for data import.");
+    }
+
+    ChunkQueue queue;
+    std::thread inflater([&]() {
+        std::exception_ptr failure;
+        try {
+            inflateStream(input, queue);
+        } catch (...) {
+            failure = std::current_exception();
+        }
+        queue.finish(failure);
+    });
+    struct InflaterGuard {
+        ChunkQueue& queue;
+        std::thread& thread;
+        ~InflaterGuard() {
+            queue.cancel();
+            thread.join();
+        }
+    } guard{queue, inflater};
+
+    // CSV is parsed up to the last complete line of each chunk; binary payloads are parsed once complete
+    std::string pending;
+    std::string chunk;
+    bool decided = false;
+    bool binary = false;
+    while (queue.pop(chunk)) {
+        pending.append(chunk);
+        if (!decided) {
+            if (pending.size() < IoTDataBinaryFormat::kMagicSize) {
+                continue;
+            }
+            binary = isBinaryPayload(pending);
+            decided = true;
+        }
+        if (binary) {
+            continue;
+        }
+        size_t cut = pending.find_last_of('\n');
+        if (cut == std::string::npos) {
+            continue;
+        }
+        if (!parseCsv(pending.data(), pending.data() + cut + 1, values, timestamps)) {
+            return;
+        }
+        pending.erase(0, cut + 1);
+    }
+
+    if (decided && binary) {
+        IoTDataBinaryFormat::readBuffer(pending.data(), pending.size(), values, timestamps);
+    } else {
+        parseCsv(pending.c_str(), pending.c_str() + pending.size(), values, timestamps);
+    }
+}
+
+#endif // IOTDATAKIT_HAVE_ZLIB
+
+} // namespace
+
+bool isGzipFile(const std::string& filename) {
+    std::ifstream input(filename, std::ios::binary);
+    unsigned char magic[2];
+    return input.read(reinterpret_cast<char*>(magic), sizeof(magic)) && std::memcmp(magic, kGzipMagic, 2) == 0;
+}
+
+#ifdef IOTDATAKIT_HAVE_ZLIB
+
+void readFile(const std::string& filename, std::vector<double>& values, std::vector<double>& timestamps,
+              size_t threadCount) {
+    std::ifstream input(filename, std::ios::binary);
+    if (!input.is_open()) {
+        throw IoTDataFileException("Error: Unable to open the file for data import.");
+    }
+    // Only files whose first member carries the "IK" subfield are loaded whole; the rest are streamed
+    unsigned char header[kMemberHeaderSize];
+    if (!input.read(reinterpret_cast<char*>(header), sizeof(header)) || !isMemberHeader(header)) {
+        input.close();
+        readStream(filename, values, timestamps);
+        return;
+    }
+    input.seekg(0);
+    std::vector<unsigned char> file((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    input.close();
+
+    std::vector<MemberLocation> members = locateMembers(file);
+    if (members.empty()) {
+        file = std::vector<unsigned char>();
+        readStream(filename, values, timestamps);
+        return;
+    }
+    readMembers(file, members, values, timestamps, threadCount);
+}
+
+void writeFile(const std::string& filename, const double* values, const double* timestamps, size_t count,
+               ExportFormat format, int level, size_t threadCount) {
+    if (level < 1 || level > 9) {
+        throw IoTDataException("Error: Compression level must be between 1 and 9.");
+    }
+
+    std::ofstream output(filename, std::ios::binary | std::ios::trunc);
+    if (!output.is_open()) {
+        throw IoTDataFileException("Error: Unable to open the file for data export.");
+    }
+
+    // Members are built and compressed a round at a time, then written in order
+    size_t memberCount = std::max<size_t>(1, (count + kMemberPoints - 1) / kMemberPoints);
+    size_t threads = IoTDataSort::resolveThreadCount(threadCount, count);
+    size_t roundSize = threads * 2;
+    std::vector<std::string> compressed(roundSize);
+    for (size_t first = 0; first < memberCount; first += roundSize) {
+        size_t round = std::min(roundSize, memberCount - first);
+        forEachIndex(round, threads, [&](size_t i) {
+            compressed[i] = compressMember(memberPayload(values, timestamps, count, format, first + i), level);
+        });
+        for (size_t i = 0; i < round; ++i) {
+            output.write(compressed[i].data(), static_cast<std::streamsize>(compressed[i].size()));
+        }
+    }
+
+    output.close();
+    if (!output) {
+        throw IoTDataFileException("Error: Unable to write the compressed export.");
+    }
+}
+
+#else
+
+void readFile(const std::string&, std::vector<double>&, std::vector<double>&, size_t) {
+    throw IoTDataFileException("Error: Compressed files require zlib support.");
+}
+
+void writeFile(const std::string&, const double*, const double*, size_t, ExportFormat, int, size_t) {
+    throw IoTDataFileException("Error: Compressed files require zlib support.");
+}
+
+#endif // IOTDATAKIT_HAVE_ZLIB
+
+} // namespace IoTDataGzip
@@ -0,0 +1,34 @@
+// IoTDataGzip.h
+// Internal gzip import/export of CSV and binary series files.
+//
+// Written files are a sequence of independent gzip members of at most kMemberPoints points each (whole CSV
+// lines, or one binary block with the file magic leading the first member). Every member header carries an
+// "IK" extra subfield with the member's compressed and uncompressed size, so a reader can find all members
+// from their headers and inflate and parse them in parallel. Standard gzip tools read these files as one
+// stream; gzip files from other tools are imported with inflation pipelined against parsing.
+#ifndef IOT_DATA_GZIP_H
+#define IOT_DATA_GZIP_H
+
+#include "IoTData.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace IoTDataGzip {
+
+constexpr size_t kMemberPoints = 64 * 1024;
+
+// True when the file starts with the gzip magic bytes
+bool isGzipFile(const std::string& filename);
+
+// Decompresses a CSV or binary series file, appending to the columns (0 threads = hardware concurrency)
+void readFile(const std::string& filename, std::vector<double>& values, std::vector<double>& timestamps,
+              size_t threadCount);
+
+// Writes the columns as a multi-member gzip file, compressing members in parallel
+void writeFile(const std::string& filename, const double* values, const double* timestamps, size_t count,
+               ExportFormat format, int level, size_t threadCount);
+
+} // namespace IoTDataGzip
+
+#endif // IOT_DATA_GZIP_H
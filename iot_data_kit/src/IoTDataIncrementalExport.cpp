@@ -0,0 +1,203 @@
+// IoTDataIncrementalExport.cpp
+#include "IoTDataIncrementalExport.h"
+#include "IoTDataBinaryFormat.h"
+#include "IoTDataException.h"
+#include "IoTDataSnapshot.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+namespace {
+
+const char* kWatermarkFile = "watermarks.csv";
+
+} // namespace
+
+IoTDataIncrementalExporter::IoTDataIncrementalExporter(const std::string& directory, ExportFormat format)
+    : directory(directory), format(format) {
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        throw IoTDataFileException("Error: Unable to create the export directory.");
+    }
+    loadWatermarks();
+}
+
+void IoTDataIncrementalExporter::setCompactionInterval(size_t deltaExports) {
+    compactionInterval = deltaExports;
+}
+
+std::string IoTDataIncrementalExporter::seriesPath(const std::string& seriesId, const std::string& extension) const {
+    if (seriesId.empty() || seriesId == "." || seriesId == ".." || seriesId.find('/') != std::string::npos) {
+        throw IoTDataException("Error: Series id '" + seriesId + "' cannot be used as an export file name.");
+    }
+    return (std::filesystem::path(directory) / (seriesId + extension)).string();
+}
+
+void IoTDataIncrementalExporter::loadWatermarks() {
+    std::ifstream input((std::filesystem::path(directory) / kWatermarkFile).string());
+    if (!input.is_open()) {
+        return;
+    }
+
+    // Each line: exportedCount,lastTimestamp,deltaExports,seriesId (id last so it may contain commas)
+    std::string line;
+    while (std::getline(input, line)) {
+        std::istringstream fields(line);
+        Watermark watermark;
+        char comma1, comma2, comma3;
+        std::string seriesId;
+        if (!(fields >> watermark.exportedCount >> comma1 >> watermark.lastTimestamp >> comma2 >>
+              watermark.deltaExports >> comma3) ||
+            comma1 != ',' || comma2 != ',' || comma3 != ',' || !std::getline(fields, seriesId)) {
+            throw IoTDataFileException("Error: Invalid export watermark file.");
+        }
+        watermarks[seriesId] = watermark;
+    }
+}
+
+void IoTDataIncrementalExporter::saveWatermarks() const {
+    std::string path = (std::filesystem::path(directory) / kWatermarkFile).string();
+    std::string temporary = path + ".tmp";
+
+    std::ofstream output(temporary, std::ios::trunc);
+    if (!output.is_open()) {
+        throw IoTDataFileException("Error: Unable to write the export watermark file.");
+    }
+    output.precision(std::numeric_limits<double>::max_digits10);
+    for (const auto& entry : watermarks) {
+        output << entry.second.exportedCount << ',' << entry.second.lastTimestamp << ',' << entry.second.deltaExports
+               << ',' << entry.first << '\n';
+    }
+    output.close();
+
+    if (!output || std::rename(temporary.c_str(), path.c_str()) != 0) {
+        throw IoTDataFileException("Error: Unable to write the export watermark file.");
+    }
+}
+
+size_t IoTDataIncrementalExporter::firstUnexported(const Watermark& watermark, const IoTData& series) const {
+    IoTDataView view = series.view();
+    if (watermark.exportedCount == 0) {
+        return 0;
+    }
+
+    // Fast path: the series only grew at the tail since the last export
+    if (view.size() >= watermark.exportedCount &&
+        view.timestamp(static_cast<size_t>(watermark.exportedCount) - 1) == watermark.lastTimestamp) {
+        return static_cast<size_t>(watermark.exportedCount);
+    }
+
+    // Otherwise (trimmed, filtered or deduplicated since) resume after the last exported timestamp
+    const double* begin = view.timestamps();
+    return static_cast<size_t>(std::upper_bound(begin, begin + view.size(), watermark.lastTimestamp) - begin);
+}
+
+size_t IoTDataIncrementalExporter::exportSeries(const std::string& seriesId, const IoTData& series) {
+    Watermark& watermark = watermarks[seriesId];
+    IoTDataView view = series.view();
+    size_t first = firstUnexported(watermark, series);
+    size_t count = view.size() - first;
+    if (count == 0) {
+        return 0;
+    }
+
+    if (format == ExportFormat::BINARY) {
+        std::string path = seriesPath(seriesId, ".bin");
+        bool needsHeader = !std::filesystem::exists(path) || std::filesystem::file_size(path) == 0;
+
+        std::ofstream output(path, std::ios::binary | std::ios::app);
+        if (!output.is_open()) {
+            throw IoTDataFileException("Error: Unable to open the file for incremental export.");
+        }
+        if (needsHeader) {
+            IoTDataBinaryFormat::writeHeader(output);
+        }
+        IoTDataBinaryFormat::writeBlocks(output, view.values() + first, view.timestamps() + first, count);
+        output.close();
+        if (!output) {
+            throw IoTDataFileException("Error: Unable to write the incremental export.");
+        }
+    } else {
+        std::ofstream output(seriesPath(seriesId, ".csv"), std::ios::app);
+        if (!output.is_open()) {
+            throw IoTDataFileException("Error: Unable to open the file for incremental export.");
+        }
+        output.precision(std::numeric_limits<double>::max_digits10);
+        for (size_t i = first; i < view.size(); ++i) {
+            output << view.timestamp(i) << "," << view.value(i) << '\n';
+        }
+        output.close();
+        if (!output) {
+            throw IoTDataFileException("Error: Unable to write the incremental export.");
+        }
+    }
+
+    watermark.exportedCount = view.size();
+    watermark.lastTimestamp = view.timestamp(view.size() - 1);
+    ++watermark.deltaExports;
+
+    if (compactionInterval != 0 && watermark.deltaExports >= compactionInterval) {
+        compact(seriesId, series);
+    } else {
+        saveWatermarks();
+    }
+
+    return count;
+}
+
+size_t IoTDataIncrementalExporter::exportStore(const IoTDataStore& store) {
+    size_t total = 0;
+    for (const auto& entry : store) {
+        total += exportSeries(entry.first, entry.second);
+    }
+    return total;
+}
+
+void IoTDataIncrementalExporter::compact(const std::string& seriesId, const IoTData& series) {
+    // The snapshot is renamed into place before the delta log is dropped, and restore
+    // ignores deltas already covered by the snapshot, so a crash in between is harmless
+    IoTDataSnapshot::save(series, seriesPath(seriesId, ".snap"));
+    std::remove(seriesPath(seriesId, format == ExportFormat::BINARY ? ".bin" : ".csv").c_str());
+
+    Watermark& watermark = watermarks[seriesId];
+    IoTDataView view = series.view();
+    watermark.exportedCount = view.size();
+    watermark.lastTimestamp = view.empty() ? 0.0 : view.timestamp(view.size() - 1);
+    watermark.deltaExports = 0;
+    saveWatermarks();
+}
+
+IoTData IoTDataIncrementalExporter::restore(const std::string& seriesId) const {
+    std::string snapshotPath = seriesPath(seriesId, ".snap");
+    IoTData series = std::filesystem::exists(snapshotPath) ? IoTDataSnapshot::load(snapshotPath)
+                                                           : IoTData(std::vector<double>());
+
+    std::string deltaPath = seriesPath(seriesId, format == ExportFormat::BINARY ? ".bin" : ".csv");
+    uintmax_t emptySize = format == ExportFormat::BINARY ? IoTDataBinaryFormat::kMagicSize : 0;
+    if (!std::filesystem::exists(deltaPath) || std::filesystem::file_size(deltaPath) <= emptySize) {
+        return series;
+    }
+
+    IoTData delta(std::vector<double>{});
+    delta.importDataFromFile(deltaPath);
+
+    IoTDataView restored = series.view();
+    IoTDataView deltaView = delta.view();
+    bool hasSnapshotPoints = !restored.empty();
+    double snapshotEnd = hasSnapshotPoints ? restored.timestamp(restored.size() - 1) : 0.0;
+    for (size_t i = 0; i < deltaView.size(); ++i) {
+        if (!hasSnapshotPoints || deltaView.timestamp(i) > snapshotEnd) {
+            series.appendData(deltaView.value(i), deltaView.timestamp(i));
+        }
+    }
+    return series;
+}
+
+uint64_t IoTDataIncrementalExporter::getExportedCount(const std::string& seriesId) const {
+    auto it = watermarks.find(seriesId);
+    return it == watermarks.end() ? 0 : it->second.exportedCount;
+}
@@ -0,0 +1,163 @@
+// IoTDataMultiChannel.cpp
+#include "IoTDataMultiChannel.h"
+#include "IoTDataException.h"
+#include "IoTDataSimd.h"
+#include <cmath>
+
+IoTDataMultiChannel::IoTDataMultiChannel(size_t channelCount) : channels(channelCount) {
+    if (channelCount == 0) {
+        throw IoTDataException("Error: A multi-channel series needs at least one channel.");
+    }
+    for (size_t c = 0; c < channelCount; ++c) {
+        channelNames.push_back("channel" + std::to_string(c));
+    }
+}
+
+IoTDataMultiChannel::IoTDataMultiChannel(const std::vector<std::string>& channelNames)
+    : channelNames(channelNames), channels(channelNames.size()) {
+    if (channelNames.empty()) {
+        throw IoTDataException("Error: A multi-channel series needs at least one channel.");
+    }
+}
+
+void IoTDataMultiChannel::checkChannel(size_t channel) const {
+    if (channel >= channels.size()) {
+        throw IoTDataException("Error: Channel index out of range.");
+    }
+}
+
+std::vector<const double*> IoTDataMultiChannel::channelColumns() const {
+    std::vector<const double*> columns;
+    columns.reserve(channels.size());
+    for (const std::vector<double>& column : channels) {
+        columns.push_back(column.data());
+    }
+    return columns;
+}
+
+void IoTDataMultiChannel::appendData(const double* values, double timestamp) {
+    timestamps.push_back(timestamp);
+    for (size_t c = 0; c < channels.size(); ++c) {
+        channels[c].push_back(values[c]);
+    }
+}
+
+void IoTDataMultiChannel::appendData(const std::vector<double>& values, double timestamp) {
+    if (values.size() != channels.size()) {
+        throw IoTDataException("Error: Reading does not match the number of channels.");
+    }
+    appendData(values.data(), timestamp);
+}
+
+void IoTDataMultiChannel::clearData() {
+    timestamps.clear();
+    for (std::vector<double>& column : channels) {
+        column.clear();
+    }
+}
+
+size_t IoTDataMultiChannel::getDataSize() const {
+    return timestamps.size();
+}
+
+size_t IoTDataMultiChannel::getChannelCount() const {
+    return channels.size();
+}
+
+const std::string& IoTDataMultiChannel::getChannelName(size_t channel) const {
+    checkChannel(channel);
+    return channelNames[channel];
+}
+
+size_t IoTDataMultiChannel::findChannel(const std::string& name) const {
+    for (size_t c = 0; c < channelNames.size(); ++c) {
+        if (channelNames[c] == name) {
+            return c;
+        }
+    }
+    throw IoTDataException("Error: Unknown channel '" + name + "'.");
+}
+
+IoTDataView IoTDataMultiChannel::channelView(size_t channel) const {
+    checkChannel(channel);
+    return IoTDataView(channels[channel].data(), timestamps.data(), timestamps.size());
+}
+
+IoTData IoTDataMultiChannel::toIoTData(size_t channel) const {
+    checkChannel(channel);
+    return IoTData(channels[channel], timestamps);
+}
+
+double IoTDataMultiChannel::calculateMean(size_t channel) const {
+    checkChannel(channel);
+    if (timestamps.empty()) {
+        throw IoTDataEmptyException("Error: No data available for mean calculation.");
+    }
+
+    double mean = IoTDataSimd::sum(channels[channel].data(), timestamps.size()) / timestamps.size();
+    if (std::isnan(mean) || std::isinf(mean)) {
+        throw IoTDataException("Error: Sum of data values resulted in an invalid value (NaN or infinity).");
+    }
+    return mean;
+}
+
+double IoTDataMultiChannel::calculateStandardDeviation(size_t channel) const {
+    checkChannel(channel);
+    if (timestamps.size() < 2) {
+        throw IoTDataInsufficientException("Error: Insufficient data for standard deviation calculation.");
+    }
+
+    double mean = calculateMean(channel);
+    return std::sqrt(IoTDataSimd::sumSquaredDeviations(channels[channel].data(), timestamps.size(), mean) /
+                     timestamps.size());
+}
+
+std::vector<double> IoTDataMultiChannel::calculateChannelMeans() const {
+    std::vector<double> means(channels.size());
+    for (size_t c = 0; c < channels.size(); ++c) {
+        means[c] = calculateMean(c);
+    }
+    return means;
+}
+
+std::vector<double> IoTDataMultiChannel::calculateChannelStandardDeviations() const {
+    std::vector<double> deviations(channels.size());
+    for (size_t c = 0; c < channels.size(); ++c) {
+        deviations[c] = calculateStandardDeviation(c);
+    }
+    return deviations;
+}
+
+std::vector<double> IoTDataMultiChannel::calculateMagnitude() const {
+    if (timestamps.empty()) {
+        throw IoTDataEmptyException("Error: No data available for magnitude calculation.");
+    }
+
+    std::vector<double> magnitude(timestamps.size());
+    std::vector<const double*> columns = channelColumns();
+    IoTDataSimd::magnitude(columns.data(), columns.size(), timestamps.size(), magnitude.data());
+    return magnitude;
+}
+
+std::vector<double> IoTDataMultiChannel::calculateProjection(const std::vector<double>& axis) const {
+    if (axis.size() != channels.size()) {
+        throw IoTDataException("Error: Projection axis does not match the number of channels.");
+    }
+    if (timestamps.empty()) {
+        throw IoTDataEmptyException("Error: No data available for projection.");
+    }
+
+    std::vector<double> projection(timestamps.size());
+    std::vector<const double*> columns = channelColumns();
+    IoTDataSimd::weightedSum(columns.data(), axis.data(), columns.size(), timestamps.size(), projection.data());
+    return projection;
+}
+
+double IoTDataMultiChannel::calculateDotProduct(size_t first, size_t second) const {
+    checkChannel(first);
+    checkChannel(second);
+    if (timestamps.empty()) {
+        throw IoTDataEmptyException("Error: No data available for dot product calculation.");
+    }
+    return IoTDataSimd::dotProduct(channels[first].data(), channels[second].data(), timestamps.size());
+}
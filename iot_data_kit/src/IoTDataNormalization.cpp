@@ -0,0 +1,71 @@
+// IoTDataNormalization.cpp
+#include "IoTDataNormalization.h"
+#include "IoTDataException.h"
+#include <cmath>
+
+IoTDataRunningNormalizer::IoTDataRunningNormalizer(NormalizationMethod method) : method(method) {
+    if (method == NormalizationMethod::ROBUST) {
+        throw IoTDataException("Error: Robust normalization has no streaming variant.");
+    }
+}
+
+void IoTDataRunningNormalizer::add(double value) {
+    ++count;
+    double delta = value - mean;
+    mean += delta / count;
+    m2 += delta * (value - mean);
+
+    if (count == 1) {
+        minimum = maximum = value;
+    } else {
+        minimum = value < minimum ? value : minimum;
+        maximum = value > maximum ? value : maximum;
+    }
+}
+
+void IoTDataRunningNormalizer::reset() {
+    count = 0;
+    mean = m2 = minimum = maximum = 0.0;
+}
+
+size_t IoTDataRunningNormalizer::attach(IoTData& series) {
+    // The normalizer must outlive the series, or the listener must be removed first
+    return series.addAppendListener([this](double value, double) { add(value); });
+}
+
+size_t IoTDataRunningNormalizer::attach(IoTData& series, IoTData& normalized) {
+    return series.addAppendListener([this, &normalized](double value, double timestamp) {
+        add(value);
+        normalized.appendData(normalize(value), timestamp);
+    });
+}
+
+double IoTDataRunningNormalizer::normalize(double value) const {
+    if (count == 0) {
+        throw IoTDataEmptyException("Error: No data available for normalization.");
+    }
+
+    double center = method == NormalizationMethod::MIN_MAX ? minimum : mean;
+    double spread = method == NormalizationMethod::MIN_MAX ? maximum - minimum : getStandardDeviation();
+    return spread > 0.0 ? (value - center) / spread : value - center;
+}
+
+size_t IoTDataRunningNormalizer::getCount() const {
+    return count;
+}
+
+double IoTDataRunningNormalizer::getMean() const {
+    return mean;
+}
+
+double IoTDataRunningNormalizer::getStandardDeviation() const {
+    return count == 0 ? 0.0 : std::sqrt(m2 / count);
+}
+
+double IoTDataRunningNormalizer::getMinimum() const {
+    return minimum;
+}
+
+double IoTDataRunningNormalizer::getMaximum() const {
+    return maximum;
+}
@@ -0,0 +1,361 @@
+// IoTDataPlot.cpp
+#include "IoTDataPlot.h"
+#include "IoTDataException.h"
+#include "IoTDataPng.h"
+#include "IoTDataSimd.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+constexpr size_t kMinimumSize = 32;
+constexpr uint8_t kBackgroundIndex = 0;
+constexpr uint8_t kAxisIndex = 1;
+constexpr uint8_t kLineIndex = 2;
+
+// Pixel geometry of the plot area and the data ranges mapped onto it
+struct Layout {
+    size_t left;
+    size_t top;
+    size_t width;
+    size_t height;
+    double minimum;
+    double maximum;
+    double startTime;
+    double endTime;
+    std::vector<IoTDataPlotColumn> columns;
+};
+
+struct Point {
+    double x;
+    double y;
+};
+
+Layout computeLayout(const IoTDataView& view, const IoTDataPlotOptions& options, bool withLabels) {
+    if (view.empty()) {
+        throw IoTDataEmptyException("Error: No data available for plotting.");
+    }
+    if (options.width < kMinimumSize || options.height < kMinimumSize) {
+        throw IoTDataException("Error: Plot size must be at least 32x32 pixels.");
+    }
+
+    // Labels need room on the left (value range), at the bottom (time range) and for the title
+    Layout layout;
+    layout.left = withLabels ? std::min<size_t>(72, options.width / 4) : 4;
+    layout.top = withLabels && !options.title.empty() ? std::min<size_t>(28, options.height / 4) : 8;
+    size_t right = withLabels ? 12 : 4;
+    size_t bottom = withLabels ? std::min<size_t>(24, options.height / 4) : 4;
+    layout.width = options.width - layout.left - right;
+    layout.height = options.height - layout.top - bottom;
+
+    IoTDataSimd::minMax(view.timestamps(), view.size(), layout.startTime, layout.endTime);
+    layout.columns = IoTDataPlot::downsample(view, layout.width);
+
+    layout.minimum = std::numeric_limits<double>::infinity();
+    layout.maximum = -std::numeric_limits<double>::infinity();
+    for (const IoTDataPlotColumn& column : layout.columns) {
+        if (column.points > 0) {
+            layout.minimum = std::min(layout.minimum, column.minimum);
+            layout.maximum = std::max(layout.maximum, column.maximum);
+        }
+    }
+    if (!std::isfinite(layout.minimum) || !std::isfinite(layout.maximum)) {
+        throw IoTDataException("Error: Data contains no finite values to plot.");
+    }
+    if (layout.minimum == layout.maximum) {
+        layout.minimum -= 0.5;
+        layout.maximum += 0.5;
+    }
+    return layout;
+}
+
+// Polyline through first/min/max/last of every non-empty column, in pixel coordinates
+std::vector<Point> linePoints(const Layout& layout) {
+    std::vector<Point> points;
+    points.reserve(layout.columns.size() * 4);
+    double scale = (layout.height - 1) / (layout.maximum - layout.minimum);
+    auto y = [&](double value) { return layout.top + (layout.maximum - value) * scale; };
+
+    for (size_t c = 0; c < layout.columns.size(); ++c) {
+        const IoTDataPlotColumn& column = layout.columns[c];
+        if (column.points == 0) {
+            continue;
+        }
+        double x = layout.left + c + 0.5;
+        points.push_back({x, y(column.first)});
+        if (column.points > 1) {
+            points.push_back({x, y(column.minimum)});
+            points.push_back({x, y(column.maximum)});
+            points.push_back({x, y(column.last)});
+        }
+    }
+    return points;
+}
+
+void appendFormat(std::string& out, const char* format, double a) {
+    char buffer[64];
+    int length = std::snprintf(buffer, sizeof(buffer), format, a);
+    out.append(buffer, static_cast<size_t>(std::max(0, length)));
+}
+
+// Pixel coordinates (non-negative) with one decimal; snprintf dominated SVG rendering time
+void appendCoordinate(std::string& out, double value, char separator) {
+    char buffer[24];
+    char* end = buffer + sizeof(buffer);
+    char* cursor = end;
+    *--cursor = separator;
+    unsigned long tenths = static_cast<unsigned long>(std::lround(std::max(0.0, value) * 10.0));
+    *--cursor = static_cast<char>('0' + tenths % 10);
+    *--cursor = '.';
+    tenths /= 10;
+    do {
+        *--cursor = static_cast<char>('0' + tenths % 10);
+        tenths /= 10;
+    } while (tenths > 0);
+    out.append(cursor, static_cast<size_t>(end - cursor));
+}
+
+std::string colorString(uint32_t color) {
+    char buffer[8];
+    std::snprintf(buffer, sizeof(buffer), "#%06X", color & 0xFFFFFF);
+    return buffer;
+}
+
+std::string escapeXml(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        switch (c) {
+            case '&': escaped += "&amp;"; break;
+            case '<': escaped += "&lt;"; break;
+            case '>': escaped += "&gt;"; break;
+            case '"': escaped += "&quot;"; break;
+            default: escaped += c; break;
+        }
+    }
+    return escaped;
+}
+
+void appendText(std::string& svg, double x, double y, const char* anchor, const std::string& text) {
+    svg += "<text x=\"";
+    appendFormat(svg, "%.1f", x);
+    svg += "\" y=\"";
+    appendFormat(svg, "%.1f", y);
+    svg += "\" text-anchor=\"";
+    svg += anchor;
+    svg += "\">";
+    svg += escapeXml(text);
+    svg += "</text>\n";
+}
+
+std::string formatNumber(double value) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.6g", value);
+    return buffer;
+}
+
+void drawLine(std::vector<uint8_t>& pixels, size_t width, long x0, long y0, long x1, long y1, uint8_t color) {
+    long dx = std::labs(x1 - x0);
+    long dy = -std::labs(y1 - y0);
+    long stepX = x0 < x1 ? 1 : -1;
+    long stepY = y0 < y1 ? 1 : -1;
+    long error = dx + dy;
+    while (true) {
+        pixels[static_cast<size_t>(y0) * width + static_cast<size_t>(x0)] = color;
+        if (x0 == x1 && y0 == y1) {
+            break;
+        }
+        long doubled = 2 * error;
+        if (doubled >= dy) {
+            error += dy;
+            x0 += stepX;
+        }
+        if (doubled <= dx) {
+            error += dx;
+            y0 += stepY;
+        }
+    }
+}
+
+void writeFile(const std::string& filename, const char* bytes, size_t size) {
+    std::ofstream output(filename, std::ios::binary | std::ios::trunc);
+    if (!output.is_open()) {
+        throw IoTDataFileException("Error: Unable to open the file for plot output.");
+    }
+    output.write(bytes, static_cast<std::streamsize>(size));
+    output.close();
+    if (!output) {
+        throw IoTDataFileException("Error: Unable to write the plot output.");
+    }
+}
+
+} // namespace
+
+std::vector<IoTDataPlotColumn> IoTDataPlot::downsample(const IoTDataView& view, size_t columns) {
+    std::vector<IoTDataPlotColumn> result(columns, IoTDataPlotColumn{0.0, 0.0, 0.0, 0.0, 0});
+    if (view.empty() || columns == 0) {
+        return result;
+    }
+
+    double startTime;
+    double endTime;
+    IoTDataSimd::minMax(view.timestamps(), view.size(), startTime, endTime);
+    double scale = endTime > startTime ? columns / (endTime - startTime) : 0.0;
+
+    for (size_t i = 0; i < view.size(); ++i) {
+        double value = view.value(i);
+        if (std::isnan(value)) {
+            continue;
+        }
+        size_t index = std::min(columns - 1, static_cast<size_t>((view.timestamp(i) - startTime) * scale));
+        IoTDataPlotColumn& column = result[index];
+        if (column.points == 0) {
+            column = {value, value, value, value, 1};
+        } else {
+            column.last = value;
+            column.minimum = std::min(column.minimum, value);
+            column.maximum = std::max(column.maximum, value);
+            ++column.points;
+        }
+    }
+    return result;
+}
+
+std::string IoTDataPlot::renderSvg(const IoTDataView& view, const IoTDataPlotOptions& options) {
+    Layout layout = computeLayout(view, options, true);
+    std::vector<Point> points = linePoints(layout);
+
+    // Built in memory and written once; ~16 bytes per polyline point
+    std::string svg;
+    svg.reserve(1024 + points.size() * 16);
+    svg += "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" + std::to_string(options.width) + "\" height=\"" +
+           std::to_string(options.height) + "\" font-family=\"sans-serif\" font-size=\"11\">\n";
+    svg += "<rect width=\"100%\" height=\"100%\" fill=\"" + colorString(options.backgroundColor) + "\"/>\n";
+    svg += "<rect x=\"" + std::to_string(layout.left) + "\" y=\"" + std::to_string(layout.top) + "\" width=\"" +
+           std::to_string(layout.width) + "\" height=\"" + std::to_string(layout.height) +
+           "\" fill=\"none\" stroke=\"" + colorString(options.axisColor) + "\"/>\n";
+
+    svg += "<g fill=\"" + colorString(options.axisColor) + "\">\n";
+    if (!options.title.empty()) {
+        appendText(svg, options.width / 2.0, layout.top - 10.0, "middle", options.title);
+    }
+    appendText(svg, layout.left - 4.0, layout.top + 10.0, "end", formatNumber(layout.maximum));
+    appendText(svg, layout.left - 4.0, static_cast<double>(layout.top + layout.height), "end",
+               formatNumber(layout.minimum));
+    appendText(svg, static_cast<double>(layout.left), layout.top + layout.height + 14.0, "start",
+               formatNumber(layout.startTime));
+    appendText(svg, static_cast<double>(layout.left + layout.width), layout.top + layout.height + 14.0, "end",
+               formatNumber(layout.endTime));
+    svg += "</g>\n";
+
+    svg += "<polyline fill=\"none\" stroke=\"" + colorString(options.lineColor) + "\" points=\"";
+    for (const Point& point : points) {
+        appendCoordinate(svg, point.x, ',');
+        appendCoordinate(svg, point.y, ' ');
+    }
+    svg += "\"/>\n</svg>\n";
+    return svg;
+}
+
+std::vector<uint8_t> IoTDataPlot::renderPng(const IoTDataView& view, const IoTDataPlotOptions& options) {
+    Layout layout = computeLayout(view, options, false);
+    std::vector<Point> points = linePoints(layout);
+
+    size_t width = options.width;
+    std::vector<uint8_t> pixels(width * options.height, kBackgroundIndex);
+    long left = static_cast<long>(layout.left) - 1;
+    long top = static_cast<long>(layout.top) - 1;
+    long right = static_cast<long>(layout.left + layout.width);
+    long bottom = static_cast<long>(layout.top + layout.height);
+    drawLine(pixels, width, left, top, right, top, kAxisIndex);
+    drawLine(pixels, width, right, top, right, bottom, kAxisIndex);
+    drawLine(pixels, width, right, bottom, left, bottom, kAxisIndex);
+    drawLine(pixels, width, left, bottom, left, top, kAxisIndex);
+
+    for (size_t i = 0; i < points.size(); ++i) {
+        const Point& from = points[i == 0 ? 0 : i - 1];
+        const Point& to = points[i];
+        drawLine(pixels, width, static_cast<long>(from.x), std::lround(from.y), static_cast<long>(to.x),
+                 std::lround(to.y), kLineIndex);
+    }
+
+    return IoTDataPng::encodeIndexed(pixels.data(), width, options.height,
+                                     {options.backgroundColor, options.axisColor, options.lineColor});
+}
+
+void IoTDataPlot::render(const IoTDataView& view, const std::string& filename, const IoTDataPlotOptions& options) {
+    if (options.format == PlotFormat::PNG) {
+        std::vector<uint8_t> png = renderPng(view, options);
+        writeFile(filename, reinterpret_cast<const char*>(png.data()), png.size());
+    } else {
+        std::string svg = renderSvg(view, options);
+        writeFile(filename, svg.data(), svg.size());
+    }
+}
+
+void IoTDataPlot::renderStore(const IoTDataStore& store, const std::string& directory,
+                              const IoTDataPlotOptions& options, size_t threadCount) {
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        throw IoTDataFileException("Error: Unable to create the plot directory.");
+    }
+
+    std::vector<std::pair<std::string, IoTDataView>> pending;
+    for (const auto& entry : store) {
+        const std::string& seriesId = entry.first;
+        if (seriesId.empty() || seriesId == "." || seriesId == ".." || seriesId.find('/') != std::string::npos) {
+            throw IoTDataException("Error: Series id '" + seriesId + "' cannot be used as a plot file name.");
+        }
+        if (entry.second.getDataSize() > 0) {
+            pending.emplace_back(seriesId, entry.second.view());
+        }
+    }
+
+    if (threadCount == 0) {
+        threadCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+    threadCount = std::min(threadCount, pending.size());
+
+    const char* extension = options.format == PlotFormat::PNG ? ".png" : ".svg";
+    std::atomic<size_t> next(0);
+    std::exception_ptr firstError;
+    std::mutex errorMutex;
+    auto worker = [&]() {
+        for (size_t i = next++; i < pending.size(); i = next++) {
+            try {
+                IoTDataPlotOptions seriesOptions = options;
+                if (seriesOptions.title.empty()) {
+                    seriesOptions.title = pending[i].first;
+                }
+                std::filesystem::path path = std::filesystem::path(directory) / (pending[i].first + extension);
+                render(pending[i].second, path.string(), seriesOptions);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!firstError) {
+                    firstError = std::current_exception();
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t t = 1; t < threadCount; ++t) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+
+    if (firstError) {
+        std::rethrow_exception(firstError);
+    }
+}
@@ -0,0 +1,191 @@
+// IoTDataPng.cpp
+#include "IoTDataPng.h"
+#include <algorithm>
+#include <array>
+
+namespace IoTDataPng {
+
+namespace {
+
+const std::array<uint32_t, 256>& crcTable() {
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> entries{};
+        for (uint32_t n = 0; n < 256; ++n) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            entries[n] = c;
+        }
+        return entries;
+    }();
+    return table;
+}
+
+uint32_t crc32(const uint8_t* bytes, size_t size) {
+    const std::array<uint32_t, 256>& table = crcTable();
+    uint32_t c = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; ++i) {
+        c = table[(c ^ bytes[i]) & 0xFF] ^ (c >> 8);
+    }
+    return c ^ 0xFFFFFFFFu;
+}
+
+uint32_t adler32(const std::vector<uint8_t>& bytes) {
+    uint32_t a = 1;
+    uint32_t b = 0;
+    size_t i = 0;
+    while (i < bytes.size()) {
+        // 5552 is the largest block that cannot overflow b before the modulo
+        size_t end = std::min(bytes.size(), i + 5552);
+        for (; i < end; ++i) {
+            a += bytes[i];
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+    }
+    return (b << 16) | a;
+}
+
+void appendBigEndian(std::vector<uint8_t>& out, uint32_t value) {
+    out.push_back(static_cast<uint8_t>(value >> 24));
+    out.push_back(static_cast<uint8_t>(value >> 16));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+void appendChunk(std::vector<uint8_t>& out, const char* type, const std::vector<uint8_t>& data) {
+    appendBigEndian(out, static_cast<uint32_t>(data.size()));
+    size_t typeOffset = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data.begin(), data.end());
+    appendBigEndian(out, crc32(out.data() + typeOffset, out.size() - typeOffset));
+}
+
+// LSB-first bit packing as required by deflate
+class BitWriter {
+private:
+    std::vector<uint8_t>& out;
+    uint32_t buffer = 0;
+    int bitCount = 0;
+
+public:
+    explicit BitWriter(std::vector<uint8_t>& out) : out(out) {}
+
+    void write(uint32_t bits, int count) {
+        buffer |= bits << bitCount;
+        bitCount += count;
+        while (bitCount >= 8) {
+            out.push_back(static_cast<uint8_t>(buffer));
+            buffer >>= 8;
+            bitCount -= 8;
+        }
+    }
+
+    // Huffman codes are defined most-significant bit first
+    void writeCode(uint32_t code, int length) {
+        uint32_t reversed = 0;
+        for (int i = 0; i < length; ++i) {
+            reversed = (reversed << 1) | ((code >> i) & 1);
+        }
+        write(reversed, length);
+    }
+
+    void flush() {
+        if (bitCount > 0) {
+            out.push_back(static_cast<uint8_t>(buffer));
+        }
+        buffer = 0;
+        bitCount = 0;
+    }
+};
+
+void writeLiteralOrLength(BitWriter& writer, uint32_t symbol) {
+    if (symbol < 144) {
+        writer.writeCode(0x30 + symbol, 8);
+    } else if (symbol < 256) {
+        writer.writeCode(0x190 + symbol - 144, 9);
+    } else if (symbol < 280) {
+        writer.writeCode(symbol - 256, 7);
+    } else {
+        writer.writeCode(0xC0 + symbol - 280, 8);
+    }
+}
+
+void writeMatch(BitWriter& writer, size_t length) {
+    static const uint16_t kBase[29] = {3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+                                       31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+    static const uint8_t kExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+                                       2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+    size_t code = 28;
+    while (kBase[code] > length) {
+        --code;
+    }
+    writeLiteralOrLength(writer, static_cast<uint32_t>(257 + code));
+    writer.write(static_cast<uint32_t>(length - kBase[code]), kExtra[code]);
+    writer.writeCode(0, 5);  // Distance code 0: distance 1
+}
+
+// zlib stream of one fixed-Huffman block using distance-1 matches for byte runs
+std::vector<uint8_t> deflateRuns(const std::vector<uint8_t>& raw) {
+    std::vector<uint8_t> out = {0x78, 0x01};
+    BitWriter writer(out);
+    writer.write(1, 1);  // BFINAL
+    writer.write(1, 2);  // BTYPE = fixed Huffman
+
+    size_t i = 0;
+    while (i < raw.size()) {
+        size_t run = 0;
+        if (i > 0) {
+            while (run < 258 && i + run < raw.size() && raw[i + run] == raw[i - 1]) {
+                ++run;
+            }
+        }
+        if (run >= 3) {
+            writeMatch(writer, run);
+            i += run;
+        } else {
+            writeLiteralOrLength(writer, raw[i]);
+            ++i;
+        }
+    }
+
+    writeLiteralOrLength(writer, 256);  // End of block
+    writer.flush();
+    appendBigEndian(out, adler32(raw));
+    return out;
+}
+
+} // namespace
+
+std::vector<uint8_t> encodeIndexed(const uint8_t* pixels, size_t width, size_t height,
+                                   const std::vector<uint32_t>& palette) {
+    // Every scanline starts with filter type 0 (none)
+    std::vector<uint8_t> raw;
+    raw.reserve((width + 1) * height);
+    for (size_t y = 0; y < height; ++y) {
+        raw.push_back(0);
+        raw.insert(raw.end(), pixels + y * width, pixels + (y + 1) * width);
+    }
+
+    std::vector<uint8_t> header;
+    appendBigEndian(header, static_cast<uint32_t>(width));
+    appendBigEndian(header, static_cast<uint32_t>(height));
+    header.insert(header.end(), {8, 3, 0, 0, 0});  // 8-bit palette indices, no interlace
+
+    std::vector<uint8_t> colors;
+    for (uint32_t color : palette) {
+        colors.insert(colors.end(), {static_cast<uint8_t>(color >> 16), static_cast<uint8_t>(color >> 8),
+                                     static_cast<uint8_t>(color)});
+    }
+
+    std::vector<uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    appendChunk(png, "IHDR", header);
+    appendChunk(png, "PLTE", colors);
+    appendChunk(png, "IDAT", deflateRuns(raw));
+    appendChunk(png, "IEND", {});
+    return png;
+}
+
+} // namespace IoTDataPng
@@ -0,0 +1,20 @@
+// IoTDataPng.h
+// Internal minimal PNG encoder for palette images (no zlib dependency).
+#ifndef IOT_DATA_PNG_H
+#define IOT_DATA_PNG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace IoTDataPng {
+
+// Encodes width x height palette indices (row-major, one byte each) with up to 256 0xRRGGBB colors.
+// Pixel data is deflated with run-length matches and the fixed Huffman code, which suits
+// charts made mostly of background runs.
+std::vector<uint8_t> encodeIndexed(const uint8_t* pixels, size_t width, size_t height,
+                                   const std::vector<uint32_t>& palette);
+
+} // namespace IoTDataPng
+
+#endif // IOT_DATA_PNG_H
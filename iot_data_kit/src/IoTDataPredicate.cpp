@@ -0,0 +1,227 @@
+// IoTDataPredicate.cpp
+#include "IoTDataPredicate.h"
+#include "IoTDataBits.h"
+#include "IoTDataException.h"
+#include "IoTDataSimd.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+IoTDataSelection::IoTDataSelection(size_t rows, bool selected)
+    : words((rows + 63) / 64, selected ? ~uint64_t(0) : 0), rowCount(rows) {
+    clearTail();
+}
+
+void IoTDataSelection::clearTail() {
+    if (rowCount % 64 != 0) {
+        words.back() &= (uint64_t(1) << (rowCount % 64)) - 1;
+    }
+}
+
+size_t IoTDataSelection::lowestSetBit(uint64_t bits) {
+    return IoTDataBits::countTrailingZeros(bits);
+}
+
+size_t IoTDataSelection::size() const {
+    return rowCount;
+}
+
+size_t IoTDataSelection::count() const {
+    size_t total = 0;
+    for (uint64_t word : words) {
+        total += IoTDataBits::popCount(word);
+    }
+    return total;
+}
+
+bool IoTDataSelection::test(size_t index) const {
+    return (words[index / 64] >> (index % 64)) & 1;
+}
+
+void IoTDataSelection::set(size_t index, bool selected) {
+    if (index >= rowCount) {
+        throw IoTDataException("Error: Selection index out of range.");
+    }
+
+    uint64_t bit = uint64_t(1) << (index % 64);
+    words[index / 64] = selected ? (words[index / 64] | bit) : (words[index / 64] & ~bit);
+}
+
+IoTDataSelection& IoTDataSelection::operator&=(const IoTDataSelection& other) {
+    if (other.rowCount != rowCount) {
+        throw IoTDataException("Error: Selections cover a different number of rows.");
+    }
+
+    for (size_t w = 0; w < words.size(); ++w) {
+        words[w] &= other.words[w];
+    }
+    return *this;
+}
+
+IoTDataSelection& IoTDataSelection::operator|=(const IoTDataSelection& other) {
+    if (other.rowCount != rowCount) {
+        throw IoTDataException("Error: Selections cover a different number of rows.");
+    }
+
+    for (size_t w = 0; w < words.size(); ++w) {
+        words[w] |= other.words[w];
+    }
+    return *this;
+}
+
+void IoTDataSelection::invert() {
+    for (uint64_t& word : words) {
+        word = ~word;
+    }
+    clearTail();
+}
+
+std::vector<uint32_t> IoTDataSelection::toIndices() const {
+    std::vector<uint32_t> indices;
+    indices.reserve(count());
+    forEachSelected([&indices](size_t index) { indices.push_back(static_cast<uint32_t>(index)); });
+    return indices;
+}
+
+IoTDataPredicate::IoTDataPredicate(std::shared_ptr<const Node> node) : root(std::move(node)) {}
+
+IoTDataPredicate IoTDataPredicate::range(PredicateColumn column, double lower, double upper) {
+    if (std::isnan(lower) || std::isnan(upper)) {
+        throw IoTDataException("Error: Predicate bounds must not be NaN.");
+    }
+
+    auto node = std::make_shared<Node>();
+    node->type = NodeType::RANGE;
+    node->column = column;
+    node->lower = lower;
+    node->upper = upper;
+    return IoTDataPredicate(std::move(node));
+}
+
+IoTDataPredicate IoTDataPredicate::all() {
+    auto node = std::make_shared<Node>();
+    node->type = NodeType::ALL;
+    return IoTDataPredicate(std::move(node));
+}
+
+IoTDataPredicate IoTDataPredicate::valueBetween(double lower, double upper) {
+    return range(PredicateColumn::VALUE, lower, upper);
+}
+
+// Strict bounds are stored as the adjacent representable value so every leaf is an inclusive range
+IoTDataPredicate IoTDataPredicate::valueAbove(double threshold) {
+    const double inf = std::numeric_limits<double>::infinity();
+    return range(PredicateColumn::VALUE, std::nextafter(threshold, inf), inf);
+}
+
+IoTDataPredicate IoTDataPredicate::valueBelow(double threshold) {
+    const double inf = std::numeric_limits<double>::infinity();
+    return range(PredicateColumn::VALUE, -inf, std::nextafter(threshold, -inf));
+}
+
+IoTDataPredicate IoTDataPredicate::absValueAtMost(double threshold) {
+    return range(PredicateColumn::VALUE, -threshold, threshold);
+}
+
+IoTDataPredicate IoTDataPredicate::timeBetween(double start, double end) {
+    return range(PredicateColumn::TIMESTAMP, start, end);
+}
+
+IoTDataPredicate IoTDataPredicate::timeBefore(double end) {
+    const double inf = std::numeric_limits<double>::infinity();
+    return range(PredicateColumn::TIMESTAMP, -inf, std::nextafter(end, -inf));
+}
+
+IoTDataPredicate IoTDataPredicate::timeFrom(double start) {
+    return range(PredicateColumn::TIMESTAMP, start, std::numeric_limits<double>::infinity());
+}
+
+IoTDataPredicate IoTDataPredicate::operator&&(const IoTDataPredicate& other) const {
+    auto node = std::make_shared<Node>();
+    node->type = NodeType::AND;
+    node->left = root;
+    node->right = other.root;
+    return IoTDataPredicate(std::move(node));
+}
+
+IoTDataPredicate IoTDataPredicate::operator||(const IoTDataPredicate& other) const {
+    auto node = std::make_shared<Node>();
+    node->type = NodeType::OR;
+    node->left = root;
+    node->right = other.root;
+    return IoTDataPredicate(std::move(node));
+}
+
+IoTDataPredicate IoTDataPredicate::operator!() const {
+    auto node = std::make_shared<Node>();
+    node->type = NodeType::NOT;
+    node->left = root;
+    return IoTDataPredicate(std::move(node));
+}
+
+IoTDataSelection IoTDataPredicate::evaluate(const IoTDataView& view) const {
+    return evaluateNode(*root, view, nullptr);
+}
+
+IoTDataSelection IoTDataPredicate::evaluate(const IoTData& series) const {
+    return evaluateNode(*root, series.view(), &series.getBlockSummaries());
+}
+
+IoTDataSelection IoTDataPredicate::evaluateNode(const Node& node, const IoTDataView& view,
+                                                const std::vector<IoTDataBlockSummary>* summaries) {
+    switch (node.type) {
+        case NodeType::ALL:
+            return IoTDataSelection(view.size(), true);
+
+        case NodeType::RANGE: {
+            IoTDataSelection selection(view.size());
+            const double* column = node.column == PredicateColumn::VALUE ? view.values() : view.timestamps();
+            if (node.column == PredicateColumn::TIMESTAMP || summaries == nullptr) {
+                IoTDataSimd::rangeMask(column, view.size(), node.lower, node.upper, selection.wordData());
+                return selection;
+            }
+
+            // Blocks start on word boundaries: fully inside sets whole words, fully outside stays zero
+            constexpr size_t kWordsPerBlock = IoTData::kSummaryBlockSize / 64;
+            uint64_t* words = selection.wordData();
+            for (size_t b = 0; b < summaries->size(); ++b) {
+                const IoTDataBlockSummary& summary = (*summaries)[b];
+                size_t begin = b * IoTData::kSummaryBlockSize;
+                size_t count = std::min(IoTData::kSummaryBlockSize, view.size() - begin);
+                if (summary.maximum < node.lower || summary.minimum > node.upper) {
+                    continue;
+                }
+                if (!summary.hasNan && summary.minimum >= node.lower && summary.maximum <= node.upper) {
+                    uint64_t* block = words + b * kWordsPerBlock;
+                    std::fill(block, block + count / 64, ~uint64_t(0));
+                    if (count % 64 != 0) {
+                        block[count / 64] = (uint64_t(1) << (count % 64)) - 1;
+                    }
+                } else {
+                    IoTDataSimd::rangeMask(column + begin, count, node.lower, node.upper, words + b * kWordsPerBlock);
+                }
+            }
+            return selection;
+        }
+
+        case NodeType::AND: {
+            IoTDataSelection selection = evaluateNode(*node.left, view, summaries);
+            selection &= evaluateNode(*node.right, view, summaries);
+            return selection;
+        }
+
+        case NodeType::OR: {
+            IoTDataSelection selection = evaluateNode(*node.left, view, summaries);
+            selection |= evaluateNode(*node.right, view, summaries);
+            return selection;
+        }
+
+        case NodeType::NOT: {
+            IoTDataSelection selection = evaluateNode(*node.left, view, summaries);
+            selection.invert();
+            return selection;
+        }
+    }
+
+    return IoTDataSelection(view.size());
+}
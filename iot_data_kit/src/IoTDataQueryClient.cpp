@@ -0,0 +1,187 @@
+// IoTDataQueryClient.cpp
+#include "IoTDataQuery.h"
+#include "IoTDataException.h"
+#include "IoTDataQueryProtocol.h"
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace IoTDataQueryProtocol;
+
+IoTDataQueryClient::IoTDataQueryClient(const std::string& socketPath) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socketPath.empty() || socketPath.size() >= sizeof(address.sun_path)) {
+        throw IoTDataException("Error: Invalid query server socket path.");
+    }
+    std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+    socketFd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (socketFd < 0 || ::connect(socketFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        if (socketFd >= 0) {
+            ::close(socketFd);
+        }
+        throw IoTDataFileException("Error: Unable to connect to the query server.");
+    }
+}
+
+IoTDataQueryClient::~IoTDataQueryClient() {
+    if (socketFd >= 0) {
+        ::close(socketFd);
+    }
+}
+
+uint32_t IoTDataQueryClient::queueRange(const std::string& seriesId, double start, double end) {
+    FrameWriter frame(pendingOutput);
+    frame.put<uint32_t>(nextRequestId);
+    frame.put<uint8_t>(static_cast<uint8_t>(QueryOpcode::RANGE));
+    frame.putString(seriesId);
+    frame.put<double>(start);
+    frame.put<double>(end);
+    frame.finish();
+
+    ++outstanding;
+    return nextRequestId++;
+}
+
+uint32_t IoTDataQueryClient::queueRollup(const std::string& seriesId, double start, double end, double bucketWidth) {
+    FrameWriter frame(pendingOutput);
+    frame.put<uint32_t>(nextRequestId);
+    frame.put<uint8_t>(static_cast<uint8_t>(QueryOpcode::ROLLUP));
+    frame.putString(seriesId);
+    frame.put<double>(start);
+    frame.put<double>(end);
+    frame.put<double>(bucketWidth);
+    frame.finish();
+
+    ++outstanding;
+    return nextRequestId++;
+}
+
+uint32_t IoTDataQueryClient::queueInterpolate(const std::string& seriesId, const std::vector<double>& newTimestamps,
+                                              InterpolationMethod method) {
+    FrameWriter frame(pendingOutput);
+    frame.put<uint32_t>(nextRequestId);
+    frame.put<uint8_t>(static_cast<uint8_t>(QueryOpcode::INTERPOLATE));
+    frame.putString(seriesId);
+    frame.put<uint8_t>(static_cast<uint8_t>(method));
+    frame.put<uint64_t>(newTimestamps.size());
+    frame.putDoubles(newTimestamps.data(), newTimestamps.size());
+    frame.finish();
+
+    ++outstanding;
+    return nextRequestId++;
+}
+
+void IoTDataQueryClient::flush() {
+    size_t offset = 0;
+    while (offset < pendingOutput.size()) {
+        ssize_t sent = ::send(socketFd, pendingOutput.data() + offset, pendingOutput.size() - offset, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw IoTDataFileException("Error: Unable to send queries to the server.");
+        }
+        offset += static_cast<size_t>(sent);
+    }
+    pendingOutput.clear();
+}
+
+IoTDataQueryResponse IoTDataQueryClient::receive() {
+    if (outstanding == 0) {
+        throw IoTDataException("Error: No outstanding queries to receive.");
+    }
+    if (!pendingOutput.empty()) {
+        flush();
+    }
+
+    size_t length;
+    while ((length = completeFrameLength(input.data() + inputOffset, input.size() - inputOffset)) == 0) {
+        if (inputOffset > 0) {
+            input.erase(input.begin(), input.begin() + inputOffset);
+            inputOffset = 0;
+        }
+
+        unsigned char chunk[64 * 1024];
+        ssize_t received = ::read(socketFd, chunk, sizeof(chunk));
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received <= 0) {
+            throw IoTDataFileException("Error: Query server closed the connection.");
+        }
+        input.insert(input.end(), chunk, chunk + received);
+    }
+
+    FrameReader frame(input.data() + inputOffset + kFramePrefixSize, length - kFramePrefixSize);
+    inputOffset += length;
+    --outstanding;
+
+    IoTDataQueryResponse response;
+    response.requestId = frame.get<uint32_t>();
+    response.opcode = static_cast<QueryOpcode>(frame.get<uint8_t>());
+    if (frame.get<uint8_t>() != kStatusOk) {
+        response.error = frame.getString();
+        return response;
+    }
+
+    switch (response.opcode) {
+        case QueryOpcode::RANGE: {
+            uint64_t count = frame.get<uint64_t>();
+            response.values = frame.getDoubles(count);
+            response.timestamps = frame.getDoubles(count);
+            break;
+        }
+        case QueryOpcode::ROLLUP: {
+            uint64_t count = frame.get<uint64_t>();
+            for (uint64_t b = 0; b < count; ++b) {
+                IoTDataRollupBucket bucket;
+                bucket.start = frame.get<double>();
+                bucket.count = frame.get<uint64_t>();
+                bucket.mean = frame.get<double>();
+                bucket.min = frame.get<double>();
+                bucket.max = frame.get<double>();
+                response.buckets.push_back(bucket);
+            }
+            break;
+        }
+        case QueryOpcode::INTERPOLATE:
+            response.values = frame.getDoubles(frame.get<uint64_t>());
+            break;
+        default:
+            throw IoTDataException("Error: Unknown query opcode in response.");
+    }
+
+    return response;
+}
+
+IoTDataQueryResponse IoTDataQueryClient::receiveChecked(QueryOpcode expected) {
+    IoTDataQueryResponse response = receive();
+    if (!response.error.empty()) {
+        throw IoTDataException(response.error);
+    }
+    if (response.opcode != expected) {
+        throw IoTDataException("Error: Unexpected query response.");
+    }
+    return response;
+}
+
+IoTData IoTDataQueryClient::range(const std::string& seriesId, double start, double end) {
+    queueRange(seriesId, start, end);
+    IoTDataQueryResponse response = receiveChecked(QueryOpcode::RANGE);
+    return IoTData(response.values, response.timestamps);
+}
+
+std::vector<IoTDataRollupBucket> IoTDataQueryClient::rollup(const std::string& seriesId, double start, double end,
+                                                            double bucketWidth) {
+    queueRollup(seriesId, start, end, bucketWidth);
+    return receiveChecked(QueryOpcode::ROLLUP).buckets;
+}
+
+std::vector<double> IoTDataQueryClient::interpolate(const std::string& seriesId, const std::vector<double>& newTimestamps,
+                                                    InterpolationMethod method) {
+    queueInterpolate(seriesId, newTimestamps, method);
+    return receiveChecked(QueryOpcode::INTERPOLATE).values;
+}
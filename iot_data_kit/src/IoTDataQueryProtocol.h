@@ -0,0 +1,111 @@
+// IoTDataQueryProtocol.h
+// Internal framing helpers shared by the query server and client.
+//
+// Every frame is: uint32 payload length, uint32 request id, uint8 opcode, then the body.
+// Responses add a uint8 status after the opcode; an error status carries a message body.
+// Integers and doubles use the host byte order (the transport is local-only).
+#ifndef IOT_DATA_QUERY_PROTOCOL_H
+#define IOT_DATA_QUERY_PROTOCOL_H
+
+#include "IoTDataException.h"
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace IoTDataQueryProtocol {
+
+constexpr size_t kFramePrefixSize = 4;
+constexpr size_t kMaxFrameSize = size_t(64) << 20;
+constexpr uint8_t kStatusOk = 0;
+constexpr uint8_t kStatusError = 1;
+
+class FrameWriter {
+private:
+    std::vector<unsigned char>& buffer;
+    size_t frameStart;
+
+public:
+    explicit FrameWriter(std::vector<unsigned char>& output) : buffer(output), frameStart(output.size()) {
+        put<uint32_t>(0);  // Patched by finish()
+    }
+
+    template <typename T>
+    void put(T value) {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&value);
+        buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+    }
+
+    void putString(const std::string& text) {
+        put<uint16_t>(static_cast<uint16_t>(text.size()));
+        buffer.insert(buffer.end(), text.begin(), text.begin() + static_cast<uint16_t>(text.size()));
+    }
+
+    void putDoubles(const double* values, size_t count) {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(values);
+        buffer.insert(buffer.end(), bytes, bytes + count * sizeof(double));
+    }
+
+    void finish() {
+        uint32_t length = static_cast<uint32_t>(buffer.size() - frameStart - kFramePrefixSize);
+        std::memcpy(buffer.data() + frameStart, &length, sizeof(length));
+    }
+};
+
+class FrameReader {
+private:
+    const unsigned char* data;
+    size_t size;
+    size_t cursor = 0;
+
+public:
+    FrameReader(const unsigned char* frame, size_t frameSize) : data(frame), size(frameSize) {}
+
+    template <typename T>
+    T get() {
+        if (cursor + sizeof(T) > size) {
+            throw IoTDataException("Error: Truncated query frame.");
+        }
+        T value;
+        std::memcpy(&value, data + cursor, sizeof(T));
+        cursor += sizeof(T);
+        return value;
+    }
+
+    std::string getString() {
+        uint16_t length = get<uint16_t>();
+        if (cursor + length > size) {
+            throw IoTDataException("Error: Truncated query frame.");
+        }
+        std::string text(reinterpret_cast<const char*>(data + cursor), length);
+        cursor += length;
+        return text;
+    }
+
+    std::vector<double> getDoubles(uint64_t count) {
+        if (count > (size - cursor) / sizeof(double)) {
+            throw IoTDataException("Error: Truncated query frame.");
+        }
+        std::vector<double> values(static_cast<size_t>(count));
+        std::memcpy(values.data(), data + cursor, values.size() * sizeof(double));
+        cursor += values.size() * sizeof(double);
+        return values;
+    }
+};
+
+// Length of the complete frame at the start of buffer, or 0 if more bytes are needed
+inline size_t completeFrameLength(const unsigned char* buffer, size_t available) {
+    if (available < kFramePrefixSize) {
+        return 0;
+    }
+    uint32_t length;
+    std::memcpy(&length, buffer, sizeof(length));
+    if (length > kMaxFrameSize) {
+        throw IoTDataException("Error: Query frame exceeds the maximum size.");
+    }
+    return available >= kFramePrefixSize + length ? kFramePrefixSize + length : 0;
+}
+
+} // namespace IoTDataQueryProtocol
+
+#endif // IOT_DATA_QUERY_PROTOCOL_H
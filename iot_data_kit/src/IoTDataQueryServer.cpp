@@ -0,0 +1,333 @@
+// IoTDataQueryServer.cpp
+#include "IoTDataQuery.h"
+#include "IoTDataException.h"
+#include "IoTDataQueryProtocol.h"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace IoTDataQueryProtocol;
+
+namespace {
+
+constexpr int kMaxEvents = 64;
+constexpr size_t kReadChunk = 64 * 1024;
+
+struct Connection {
+    std::vector<unsigned char> input;
+    std::vector<unsigned char> output;
+    size_t outputOffset = 0;
+    bool peerDone = false;   // Peer half-closed: answer what arrived, close once the output is drained
+    bool closed = false;     // Close now, dropping any pending output
+};
+
+// Row range [first, last) of a sorted series covering [start, end]
+void findRange(const IoTDataView& view, double start, double end, size_t& first, size_t& last) {
+    const double* begin = view.timestamps();
+    const double* stop = begin + view.size();
+    first = static_cast<size_t>(std::lower_bound(begin, stop, start) - begin);
+    last = static_cast<size_t>(std::upper_bound(begin, stop, end) - begin);
+    last = std::max(first, last);
+}
+
+void encodeRange(const IoTData& series, FrameReader& request, FrameWriter& response) {
+    double start = request.get<double>();
+    double end = request.get<double>();
+
+    IoTDataView view = series.view();
+    size_t first, last;
+    findRange(view, start, end, first, last);
+
+    // Rejected before copying anything; processFrame enforces the exact limit for every reply
+    if (last - first > kMaxFrameSize / (2 * sizeof(double))) {
+        throw IoTDataException("Error: Query result exceeds the maximum frame size; request a narrower range.");
+    }
+    response.put<uint64_t>(last - first);
+    response.putDoubles(view.values() + first, last - first);
+    response.putDoubles(view.timestamps() + first, last - first);
+}
+
+void encodeRollup(const IoTData& series, FrameReader& request, FrameWriter& response) {
+    double start = request.get<double>();
+    double end = request.get<double>();
+    double bucketWidth = request.get<double>();
+    if (!(bucketWidth > 0.0)) {
+        throw IoTDataException("Error: Rollup bucket width must be positive.");
+    }
+
+    IoTDataView view = series.view();
+    size_t first, last;
+    findRange(view, start, end, first, last);
+
+    std::vector<IoTDataRollupBucket> buckets;
+    for (size_t i = first; i < last; ++i) {
+        double bucketStart = std::floor(view.timestamp(i) / bucketWidth) * bucketWidth;
+        double value = view.value(i);
+        if (buckets.empty() || buckets.back().start != bucketStart) {
+            buckets.push_back({bucketStart, 0, 0.0, value, value});
+        }
+        IoTDataRollupBucket& bucket = buckets.back();
+        ++bucket.count;
+        bucket.mean += value;  // Holds the sum until the bucket is complete
+        bucket.min = std::min(bucket.min, value);
+        bucket.max = std::max(bucket.max, value);
+    }
+
+    response.put<uint64_t>(buckets.size());
+    for (const IoTDataRollupBucket& bucket : buckets) {
+        response.put<double>(bucket.start);
+        response.put<uint64_t>(bucket.count);
+        response.put<double>(bucket.mean / bucket.count);
+        response.put<double>(bucket.min);
+        response.put<double>(bucket.max);
+    }
+}
+
+void encodeInterpolate(const IoTData& series, FrameReader& request, FrameWriter& response) {
+    uint8_t method = request.get<uint8_t>();
+    if (method > static_cast<uint8_t>(InterpolationMethod::CUBIC_SPLINE)) {
+        throw IoTDataException("Error: Unknown interpolation method.");
+    }
+    uint64_t count = request.get<uint64_t>();
+    std::vector<double> newTimestamps = request.getDoubles(count);
+
+    std::vector<double> values = series.interpolateData(newTimestamps, static_cast<InterpolationMethod>(method));
+    response.put<uint64_t>(values.size());
+    response.putDoubles(values.data(), values.size());
+}
+
+} // namespace
+
+IoTDataQueryServer::IoTDataQueryServer(const IoTDataStore& store, const std::string& socketPath, std::mutex* storeMutex)
+    : store(store), storeMutex(storeMutex), socketPath(socketPath) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socketPath.empty() || socketPath.size() >= sizeof(address.sun_path)) {
+        throw IoTDataException("Error: Invalid query server socket path.");
+    }
+    std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+    listenFd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (listenFd < 0 || epollFd < 0 || wakeFd < 0) {
+        closeDescriptors();
+        throw IoTDataFileException("Error: Unable to create the query server sockets.");
+    }
+
+    ::unlink(socketPath.c_str());
+    if (::bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(listenFd, SOMAXCONN) != 0) {
+        closeDescriptors();
+        throw IoTDataFileException("Error: Unable to bind the query server socket.");
+    }
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = listenFd;
+    ::epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+    event.data.fd = wakeFd;
+    ::epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event);
+}
+
+IoTDataQueryServer::~IoTDataQueryServer() {
+    closeDescriptors();
+}
+
+void IoTDataQueryServer::closeDescriptors() {
+    if (listenFd >= 0) {
+        ::close(listenFd);
+        ::unlink(socketPath.c_str());
+        listenFd = -1;
+    }
+    if (epollFd >= 0) {
+        ::close(epollFd);
+        epollFd = -1;
+    }
+    if (wakeFd >= 0) {
+        ::close(wakeFd);
+        wakeFd = -1;
+    }
+}
+
+void IoTDataQueryServer::stop() {
+    running = false;
+    uint64_t one = 1;
+    ssize_t ignored = ::write(wakeFd, &one, sizeof(one));
+    (void)ignored;
+}
+
+void IoTDataQueryServer::processFrame(const unsigned char* frame, size_t length, std::vector<unsigned char>& output) const {
+    FrameReader request(frame + kFramePrefixSize, length - kFramePrefixSize);
+    uint32_t requestId = request.get<uint32_t>();
+    uint8_t opcode = request.get<uint8_t>();
+
+    size_t rollback = output.size();
+    try {
+        FrameWriter response(output);
+        response.put<uint32_t>(requestId);
+        response.put<uint8_t>(opcode);
+        response.put<uint8_t>(kStatusOk);
+
+        const IoTData& series = store.getSeries(request.getString());
+        switch (static_cast<QueryOpcode>(opcode)) {
+            case QueryOpcode::RANGE:
+                encodeRange(series, request, response);
+                break;
+            case QueryOpcode::ROLLUP:
+                encodeRollup(series, request, response);
+                break;
+            case QueryOpcode::INTERPOLATE:
+                encodeInterpolate(series, request, response);
+                break;
+            default:
+                throw IoTDataException("Error: Unknown query opcode.");
+        }
+        // Clients reject larger frames, and the length prefix is only 32 bits
+        if (output.size() - rollback - kFramePrefixSize > kMaxFrameSize) {
+            throw IoTDataException("Error: Query result exceeds the maximum frame size; request a narrower range.");
+        }
+        response.finish();
+    } catch (const std::exception& e) {
+        output.resize(rollback);
+        FrameWriter response(output);
+        response.put<uint32_t>(requestId);
+        response.put<uint8_t>(opcode);
+        response.put<uint8_t>(kStatusError);
+        response.putString(e.what());
+        response.finish();
+    }
+}
+
+void IoTDataQueryServer::run() {
+    std::unordered_map<int, Connection> connections;
+    epoll_event events[kMaxEvents];
+
+    auto updateInterest = [this](int fd, const Connection& connection) {
+        epoll_event event{};
+        // After a half-close the socket stays readable at end of input, so only writability is of interest
+        uint32_t mask = connection.peerDone ? 0u : uint32_t(EPOLLIN | EPOLLRDHUP);
+        event.events = mask | (connection.outputOffset < connection.output.size() ? uint32_t(EPOLLOUT) : 0u);
+        event.data.fd = fd;
+        ::epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event);
+    };
+
+    while (running) {
+        int ready = ::epoll_wait(epollFd, events, kMaxEvents, -1);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw IoTDataException("Error: Query server event loop failed.");
+        }
+
+        for (int e = 0; e < ready; ++e) {
+            int fd = events[e].data.fd;
+
+            if (fd == wakeFd) {
+                uint64_t value;
+                ssize_t ignored = ::read(wakeFd, &value, sizeof(value));
+                (void)ignored;
+                continue;
+            }
+
+            if (fd == listenFd) {
+                for (;;) {
+                    int client = ::accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+                    if (client < 0) {
+                        break;
+                    }
+                    epoll_event event{};
+                    event.events = EPOLLIN | EPOLLRDHUP;
+                    event.data.fd = client;
+                    ::epoll_ctl(epollFd, EPOLL_CTL_ADD, client, &event);
+                    connections[client];
+                }
+                continue;
+            }
+
+            auto it = connections.find(fd);
+            if (it == connections.end()) {
+                continue;
+            }
+            Connection& connection = it->second;
+
+            // A read error or hang-up leaves nobody to answer; a plain end of input (half-close) is still answered
+            bool broken = (events[e].events & (EPOLLHUP | EPOLLERR)) != 0;
+            if (events[e].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+                unsigned char chunk[kReadChunk];
+                for (;;) {
+                    ssize_t received = ::read(fd, chunk, sizeof(chunk));
+                    if (received > 0) {
+                        connection.input.insert(connection.input.end(), chunk, chunk + received);
+                    } else if (received == 0) {
+                        connection.peerDone = true;
+                        break;
+                    } else if (errno != EAGAIN && errno != EINTR) {
+                        connection.closed = true;
+                        broken = true;
+                        break;
+                    } else if (errno == EAGAIN) {
+                        break;
+                    }
+                }
+
+                // Every complete frame that arrived in this read is answered as one batch
+                try {
+                    size_t consumed = 0;
+                    std::unique_lock<std::mutex> lock;
+                    if (storeMutex != nullptr) {
+                        lock = std::unique_lock<std::mutex>(*storeMutex);
+                    }
+                    while (size_t length = completeFrameLength(connection.input.data() + consumed,
+                                                               connection.input.size() - consumed)) {
+                        processFrame(connection.input.data() + consumed, length, connection.output);
+                        consumed += length;
+                    }
+                    connection.input.erase(connection.input.begin(), connection.input.begin() + consumed);
+                } catch (const IoTDataException&) {
+                    connection.closed = true;  // Oversized or malformed framing
+                }
+            }
+
+            // Answers are flushed even after the peer half-closed its side. MSG_NOSIGNAL turns a peer that went
+            // away into EPIPE instead of a SIGPIPE for the host process.
+            while (!broken && connection.outputOffset < connection.output.size()) {
+                ssize_t sent = ::send(fd, connection.output.data() + connection.outputOffset,
+                                      connection.output.size() - connection.outputOffset, MSG_NOSIGNAL);
+                if (sent > 0) {
+                    connection.outputOffset += static_cast<size_t>(sent);
+                } else if (sent < 0 && errno == EINTR) {
+                    continue;
+                } else {
+                    connection.closed = connection.closed || (sent < 0 && errno != EAGAIN);
+                    break;
+                }
+            }
+            bool drained = connection.outputOffset == connection.output.size();
+            if (drained) {
+                connection.output.clear();
+                connection.outputOffset = 0;
+            }
+
+            if (connection.closed || broken || (connection.peerDone && drained)) {
+                ::epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+                ::close(fd);
+                connections.erase(it);
+            } else {
+                updateInterest(fd, connection);
+            }
+        }
+    }
+
+    for (const auto& entry : connections) {
+        ::close(entry.first);
+    }
+}
@@ -0,0 +1,254 @@
+// IoTDataRules.cpp
+#include "IoTDataRules.h"
+#include "IoTDataException.h"
+#include <algorithm>
+#include <cmath>
+
+IoTDataRuleEngine::IoTDataRuleEngine(AlertHandler handler) : alertHandler(std::move(handler)) {}
+
+size_t IoTDataRuleEngine::findOrCreateSeries(const std::string& seriesId) {
+    auto it = seriesIndex.find(seriesId);
+    if (it != seriesIndex.end()) {
+        return it->second;
+    }
+
+    SeriesState state;
+    state.id = seriesId;
+    series.push_back(std::move(state));
+    seriesIndex.emplace(seriesId, series.size() - 1);
+    return series.size() - 1;
+}
+
+void IoTDataRuleEngine::registerSeries(const std::string& seriesId, const std::vector<std::string>& tags) {
+    if (seriesId.empty()) {
+        throw IoTDataException("Error: Series id must not be empty.");
+    }
+
+    size_t index = findOrCreateSeries(seriesId);
+
+    for (const std::string& tag : tags) {
+        SeriesState& state = series[index];
+        if (std::find(state.tags.begin(), state.tags.end(), tag) != state.tags.end()) {
+            continue;
+        }
+        state.tags.push_back(tag);
+        tagSeries[tag].push_back(index);
+
+        // Rules registered against the tag before this series existed apply to it as well
+        auto rulesIt = tagRules.find(tag);
+        if (rulesIt != tagRules.end()) {
+            for (size_t ruleId : rulesIt->second) {
+                bindRule(state, ruleId);
+            }
+        }
+    }
+}
+
+size_t IoTDataRuleEngine::attach(const std::string& seriesId, IoTData& seriesData) {
+    size_t index = findOrCreateSeries(seriesId);
+
+    // The engine must outlive the series, or the listener must be removed first
+    return seriesData.addAppendListener([this, index](double value, double timestamp) {
+        ingestSeries(series[index], value, timestamp);
+    });
+}
+
+void IoTDataRuleEngine::ingest(const std::string& seriesId, double value, double timestamp) {
+    auto it = seriesIndex.find(seriesId);
+    if (it == seriesIndex.end()) {
+        return;  // No rules can target an unknown series
+    }
+
+    ingestSeries(series[it->second], value, timestamp);
+}
+
+size_t IoTDataRuleEngine::addRule(const IoTDataRule& rule) {
+    if (rule.target.empty()) {
+        throw IoTDataException("Error: Rule target must not be empty.");
+    }
+
+    if (!(rule.window >= 0.0) || std::isinf(rule.window)) {
+        throw IoTDataException("Error: Rule window must be a finite, non-negative duration.");
+    }
+
+    if (rule.consecutive == 0) {
+        throw IoTDataException("Error: Rule must require at least one matching window.");
+    }
+
+    size_t ruleId = rules.size();
+    rules.push_back(rule);
+
+    if (rule.targetIsTag) {
+        tagRules[rule.target].push_back(ruleId);
+        auto seriesIt = tagSeries.find(rule.target);
+        if (seriesIt != tagSeries.end()) {
+            for (size_t index : seriesIt->second) {
+                bindRule(series[index], ruleId);
+            }
+        }
+    } else {
+        bindRule(series[findOrCreateSeries(rule.target)], ruleId);
+    }
+
+    return ruleId;
+}
+
+void IoTDataRuleEngine::bindRule(SeriesState& state, size_t ruleId) {
+    double window = rules[ruleId].window;
+
+    if (window == 0.0) {
+        state.sampleBindings.push_back({ruleId});
+        return;
+    }
+
+    auto it = std::find_if(state.windows.begin(), state.windows.end(),
+                           [window](const WindowState& existing) { return existing.window == window; });
+    if (it == state.windows.end()) {
+        WindowState created;
+        created.window = window;
+        state.windows.push_back(std::move(created));
+        it = state.windows.end() - 1;
+    }
+
+    it->bindings.push_back({ruleId});
+}
+
+size_t IoTDataRuleEngine::getRuleCount() const {
+    return rules.size();
+}
+
+size_t IoTDataRuleEngine::getSharedAggregateCount() const {
+    size_t count = 0;
+    for (const SeriesState& state : series) {
+        count += state.windows.size();
+    }
+    return count;
+}
+
+std::vector<IoTDataAlert> IoTDataRuleEngine::drainAlerts() {
+    std::vector<IoTDataAlert> alerts;
+    alerts.swap(pendingAlerts);
+    return alerts;
+}
+
+void IoTDataRuleEngine::ingestSeries(SeriesState& state, double value, double timestamp) {
+    // Per-sample rules share the series' previous point for rate of change
+    for (RuleBinding& binding : state.sampleBindings) {
+        const IoTDataRule& rule = rules[binding.ruleId];
+        if (rule.aggregate == RuleAggregate::RATE_OF_CHANGE) {
+            if (!state.hasPrevious || timestamp == state.previousTimestamp) {
+                continue;
+            }
+            double rate = (value - state.previousValue) / (timestamp - state.previousTimestamp);
+            evaluate(state, binding, rate, timestamp);
+        } else {
+            evaluate(state, binding, value, timestamp);
+        }
+    }
+
+    state.hasPrevious = true;
+    state.previousValue = value;
+    state.previousTimestamp = timestamp;
+
+    for (WindowState& window : state.windows) {
+        if (window.open && timestamp >= window.windowStart + window.window) {
+            double nextStart = std::floor(timestamp / window.window) * window.window;
+            double elapsed = std::round((nextStart - window.windowStart) / window.window);
+            size_t skipped = elapsed > 1.0 ? static_cast<size_t>(elapsed) - 1 : 0;
+            closeWindow(state, window, skipped);
+        }
+
+        if (!window.open) {
+            window.open = true;
+            window.windowStart = std::floor(timestamp / window.window) * window.window;
+            window.count = 0;
+            window.sum = 0.0;
+            window.min = value;
+            window.max = value;
+            window.first = value;
+            window.firstTimestamp = timestamp;
+        }
+
+        // Late points are folded into the current window rather than reopening a closed one
+        ++window.count;
+        window.sum += value;
+        window.min = std::min(window.min, value);
+        window.max = std::max(window.max, value);
+        window.last = value;
+        window.lastTimestamp = timestamp;
+    }
+}
+
+void IoTDataRuleEngine::closeWindow(SeriesState& state, WindowState& window, size_t skippedWindows) {
+    window.open = false;
+    double windowEnd = window.windowStart + window.window;
+
+    for (RuleBinding& binding : window.bindings) {
+        // Empty windows in between break any consecutive run
+        if (skippedWindows > 0) {
+            binding.matches = 0;
+        }
+
+        double aggregateValue = 0.0;
+        switch (rules[binding.ruleId].aggregate) {
+            case RuleAggregate::MEAN:
+                aggregateValue = window.sum / window.count;
+                break;
+            case RuleAggregate::MIN:
+                aggregateValue = window.min;
+                break;
+            case RuleAggregate::MAX:
+                aggregateValue = window.max;
+                break;
+            case RuleAggregate::LAST:
+                aggregateValue = window.last;
+                break;
+            case RuleAggregate::RATE_OF_CHANGE:
+                if (window.count < 2 || window.lastTimestamp == window.firstTimestamp) {
+                    binding.matches = 0;
+                    continue;
+                }
+                aggregateValue = (window.last - window.first) / (window.lastTimestamp - window.firstTimestamp);
+                break;
+        }
+
+        evaluate(state, binding, aggregateValue, windowEnd);
+    }
+}
+
+void IoTDataRuleEngine::evaluate(SeriesState& state, RuleBinding& binding, double aggregateValue, double timestamp) {
+    const IoTDataRule& rule = rules[binding.ruleId];
+
+    bool matched = false;
+    switch (rule.comparison) {
+        case RuleComparison::GREATER:
+            matched = aggregateValue > rule.threshold;
+            break;
+        case RuleComparison::GREATER_EQUAL:
+            matched = aggregateValue >= rule.threshold;
+            break;
+        case RuleComparison::LESS:
+            matched = aggregateValue < rule.threshold;
+            break;
+        case RuleComparison::LESS_EQUAL:
+            matched = aggregateValue <= rule.threshold;
+            break;
+    }
+
+    if (!matched) {
+        binding.matches = 0;
+        return;
+    }
+
+    // Fire once per run of matching windows; the rule re-arms after a miss
+    if (++binding.matches != rule.consecutive) {
+        return;
+    }
+
+    IoTDataAlert alert{binding.ruleId, rule.name, state.id, timestamp, aggregateValue};
+    if (alertHandler) {
+        alertHandler(alert);
+    } else {
+        pendingAlerts.push_back(std::move(alert));
+    }
+}
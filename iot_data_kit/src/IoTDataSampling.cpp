@@ -0,0 +1,317 @@
+// IoTDataSampling.cpp
+#include "IoTDataSampling.h"
+#include "IoTDataException.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <unordered_set>
+
+namespace {
+
+// Inverse of the standard normal CDF (Acklam's rational approximation, |error| < 1.2e-9)
+double normalQuantile(double p) {
+    static const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                               1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+    static const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                               6.680131188771972e+01, -1.328068155288572e+01};
+    static const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                               -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+    static const double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                               3.754408661907416e+00};
+    const double low = 0.02425;
+
+    if (p < low) {
+        double q = std::sqrt(-2 * std::log(p));
+        return (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+               ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1);
+    }
+    if (p > 1 - low) {
+        double q = std::sqrt(-2 * std::log(1 - p));
+        return -(((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+               ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1);
+    }
+
+    double q = p - 0.5;
+    double r = q * q;
+    return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+           (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1);
+}
+
+double criticalValue(double confidence) {
+    if (!(confidence > 0.0 && confidence < 1.0)) {
+        throw IoTDataException("Error: Confidence level must be between 0 and 1.");
+    }
+    return normalQuantile(0.5 + confidence / 2.0);
+}
+
+IoTData buildSample(const IoTDataView& view, const std::vector<size_t>& indices) {
+    std::vector<double> values;
+    std::vector<double> times;
+    values.reserve(indices.size());
+    times.reserve(indices.size());
+    for (size_t index : indices) {
+        values.push_back(view.value(index));
+        times.push_back(view.timestamp(index));
+    }
+    return IoTData(values, times);
+}
+
+} // namespace
+
+IoTDataReservoir::IoTDataReservoir(size_t capacity, uint64_t seed) : capacity(capacity), rng(seed) {
+    if (capacity == 0) {
+        throw IoTDataException("Error: Reservoir capacity must be positive.");
+    }
+    values.reserve(capacity);
+    timestamps.reserve(capacity);
+}
+
+void IoTDataReservoir::scheduleNextReplacement() {
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    double skip = std::floor(std::log(1.0 - uniform(rng)) / std::log(1.0 - weight));
+    nextReplacement = skip < static_cast<double>(std::numeric_limits<size_t>::max() - seen)
+                          ? seen + static_cast<size_t>(skip) + 1
+                          : std::numeric_limits<size_t>::max();
+}
+
+void IoTDataReservoir::add(double value, double timestamp) {
+    ++seen;
+
+    if (seen <= capacity) {
+        values.push_back(value);
+        timestamps.push_back(timestamp);
+        if (seen == capacity) {
+            std::uniform_real_distribution<double> uniform(0.0, 1.0);
+            weight = std::exp(std::log(1.0 - uniform(rng)) / capacity);
+            scheduleNextReplacement();
+        }
+        return;
+    }
+
+    // Points between replacements are skipped without drawing random numbers
+    if (seen != nextReplacement) {
+        return;
+    }
+
+    size_t slot = std::uniform_int_distribution<size_t>(0, capacity - 1)(rng);
+    values[slot] = value;
+    timestamps[slot] = timestamp;
+
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    weight *= std::exp(std::log(1.0 - uniform(rng)) / capacity);
+    scheduleNextReplacement();
+}
+
+size_t IoTDataReservoir::getSeenCount() const {
+    return seen;
+}
+
+size_t IoTDataReservoir::getSampleSize() const {
+    return values.size();
+}
+
+IoTData IoTDataReservoir::toIoTData() const {
+    std::vector<size_t> order(values.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this](size_t a, size_t b) { return timestamps[a] < timestamps[b]; });
+
+    return buildSample(IoTDataView(values.data(), timestamps.data(), values.size()), order);
+}
+
+IoTDataSampler::IoTDataSampler(uint64_t seed) : rng(seed) {}
+
+std::vector<size_t> IoTDataSampler::sampleIndices(size_t populationSize, size_t sampleSize) {
+    std::vector<size_t> indices;
+
+    if (sampleSize >= populationSize) {
+        indices.resize(populationSize);
+        std::iota(indices.begin(), indices.end(), 0);
+        return indices;
+    }
+
+    // Floyd's algorithm: sampleSize distinct indices with sampleSize random draws
+    std::unordered_set<size_t> chosen;
+    chosen.reserve(sampleSize * 2);
+    for (size_t j = populationSize - sampleSize; j < populationSize; ++j) {
+        size_t candidate = std::uniform_int_distribution<size_t>(0, j)(rng);
+        if (!chosen.insert(candidate).second) {
+            chosen.insert(j);
+        }
+    }
+
+    indices.assign(chosen.begin(), chosen.end());
+    std::sort(indices.begin(), indices.end());
+    return indices;
+}
+
+std::vector<double> IoTDataSampler::sampleValues(const IoTDataView& view, size_t sampleSize) {
+    if (view.empty()) {
+        throw IoTDataEmptyException("Error: No data available for approximate analysis.");
+    }
+    if (sampleSize == 0) {
+        throw IoTDataException("Error: Sample size must be positive.");
+    }
+
+    std::vector<double> values;
+    for (size_t index : sampleIndices(view.size(), sampleSize)) {
+        values.push_back(view.value(index));
+    }
+    return values;
+}
+
+IoTData IoTDataSampler::reservoirSample(const IoTDataView& view, size_t sampleSize) {
+    // With random access the reservoir reduces to drawing sampleSize distinct indices
+    return buildSample(view, sampleIndices(view.size(), sampleSize));
+}
+
+IoTData IoTDataSampler::bernoulliSample(const IoTDataView& view, double probability) {
+    if (!(probability > 0.0 && probability <= 1.0)) {
+        throw IoTDataException("Error: Sampling probability must be in (0, 1].");
+    }
+
+    // Geometric gaps visit only the selected points. They are drawn as doubles (failures before the next
+    // success), since for tiny probabilities a gap can exceed any integer type.
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    double logMiss = std::log1p(-probability);
+    std::vector<size_t> indices;
+    for (size_t i = 0; i < view.size(); ++i) {
+        double skip = std::floor(std::log(1.0 - uniform(rng)) / logMiss);
+        if (!(skip < static_cast<double>(view.size() - i))) {
+            break;
+        }
+        i += static_cast<size_t>(skip);
+        indices.push_back(i);
+    }
+
+    return buildSample(view, indices);
+}
+
+IoTData IoTDataSampler::stratifiedSample(const IoTDataView& view, size_t strata, size_t samplesPerStratum) {
+    if (view.empty()) {
+        throw IoTDataEmptyException("Error: No data available for stratified sampling.");
+    }
+    if (strata == 0) {
+        throw IoTDataException("Error: Number of strata must be positive.");
+    }
+
+    // Equal-width time strata; boundaries are found by binary search on the sorted timestamps
+    const double* begin = view.timestamps();
+    const double* end = begin + view.size();
+    double start = view.timestamp(0);
+    double width = (view.timestamp(view.size() - 1) - start) / strata;
+
+    std::vector<size_t> indices;
+    size_t lowerIndex = 0;
+    for (size_t s = 0; s < strata; ++s) {
+        size_t upperIndex = s + 1 == strata ? view.size()
+                                            : static_cast<size_t>(std::lower_bound(begin, end, start + width * (s + 1)) - begin);
+        upperIndex = std::max(upperIndex, lowerIndex);
+
+        for (size_t offset : sampleIndices(upperIndex - lowerIndex, samplesPerStratum)) {
+            indices.push_back(lowerIndex + offset);
+        }
+        lowerIndex = upperIndex;
+    }
+
+    return buildSample(view, indices);
+}
+
+IoTData IoTDataSampler::reservoirSampleFile(const std::string& filename, size_t sampleSize) {
+    std::ifstream inputFile(filename);
+
+    if (!inputFile.is_open()) {
+        throw IoTDataFileException("Error: Unable to open the file for sampling.");
+    }
+
+    IoTDataReservoir reservoir(sampleSize, rng());
+
+    double timestamp, value;
+    char comma;
+    while (inputFile >> timestamp >> comma >> value) {
+        if (comma != ',') {
+            throw IoTDataFileException("Error: Invalid file format. Expected comma-separated values.");
+        }
+        reservoir.add(value, timestamp);
+    }
+
+    if (reservoir.getSeenCount() == 0) {
+        throw IoTDataFileException("Error: No data found in the input file.");
+    }
+
+    return reservoir.toIoTData();
+}
+
+IoTDataEstimate IoTDataSampler::approximateMean(const IoTDataView& view, size_t sampleSize, double confidence) {
+    double z = criticalValue(confidence);
+    std::vector<double> values = sampleValues(view, sampleSize);
+    size_t m = values.size();
+
+    double mean = std::accumulate(values.begin(), values.end(), 0.0) / m;
+    if (m == view.size() || m < 2) {
+        return {mean, mean, mean, confidence, m};
+    }
+
+    double sumSquares = 0.0;
+    for (double value : values) {
+        sumSquares += (value - mean) * (value - mean);
+    }
+
+    // Standard error with the finite population correction
+    double standardError = std::sqrt(sumSquares / (m - 1) / m) *
+                           std::sqrt(static_cast<double>(view.size() - m) / (view.size() - 1));
+    return {mean, mean - z * standardError, mean + z * standardError, confidence, m};
+}
+
+IoTDataEstimate IoTDataSampler::approximateStandardDeviation(const IoTDataView& view, size_t sampleSize,
+                                                             double confidence) {
+    double z = criticalValue(confidence);
+    std::vector<double> values = sampleValues(view, sampleSize);
+    size_t m = values.size();
+
+    if (m < 2) {
+        throw IoTDataInsufficientException("Error: Insufficient data for standard deviation estimation.");
+    }
+
+    double mean = std::accumulate(values.begin(), values.end(), 0.0) / m;
+    double sumSquares = 0.0;
+    for (double value : values) {
+        sumSquares += (value - mean) * (value - mean);
+    }
+
+    if (m == view.size()) {
+        double exact = std::sqrt(sumSquares / m);
+        return {exact, exact, exact, confidence, m};
+    }
+
+    // Normal approximation to the chi-square interval for sigma
+    double deviation = std::sqrt(sumSquares / (m - 1));
+    double spread = z / std::sqrt(2.0 * (m - 1));
+    double upper = spread < 1.0 ? deviation / (1.0 - spread) : std::numeric_limits<double>::infinity();
+    return {deviation, deviation / (1.0 + spread), upper, confidence, m};
+}
+
+IoTDataEstimate IoTDataSampler::approximateQuantile(const IoTDataView& view, double quantile, size_t sampleSize,
+                                                    double confidence) {
+    if (!(quantile >= 0.0 && quantile <= 1.0)) {
+        throw IoTDataException("Error: Quantile must be between 0 and 1.");
+    }
+
+    double z = criticalValue(confidence);
+    std::vector<double> values = sampleValues(view, sampleSize);
+    std::sort(values.begin(), values.end());
+    size_t m = values.size();
+
+    double estimate = values[static_cast<size_t>(std::round(quantile * (m - 1)))];
+    if (m == view.size()) {
+        return {estimate, estimate, estimate, confidence, m};
+    }
+
+    // Distribution-free interval from the binomial distribution of the order statistics
+    double center = quantile * m;
+    double spread = z * std::sqrt(m * quantile * (1.0 - quantile));
+    double lowerRank = std::max(0.0, std::floor(center - spread));
+    double upperRank = std::min(static_cast<double>(m - 1), std::ceil(center + spread));
+    return {estimate, values[static_cast<size_t>(lowerRank)], values[static_cast<size_t>(upperRank)], confidence, m};
+}
@@ -0,0 +1,258 @@
+// IoTDataSharedRing.cpp
+#include "IoTDataSharedRing.h"
+#include "IoTDataException.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const char kRingMagic[8] = {'I', 'O', 'T', 'R', 'I', 'N', 'G', '1'};
+
+} // namespace
+
+// Shared header; the sequences sit on their own cache lines to avoid false sharing
+struct IoTDataSharedRing::RingHeader {
+    char magic[8];
+    uint64_t capacity;
+    alignas(64) std::atomic<uint64_t> claimSequence;   // Points the writer has started to write
+    alignas(64) std::atomic<uint64_t> writeSequence;   // Points fully published to readers
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared ring needs lock-free 64-bit atomics");
+
+IoTDataSharedRing::IoTDataSharedRing(const std::string& name, bool owner) : name(name), owner(owner) {}
+
+IoTDataSharedRing::IoTDataSharedRing(IoTDataSharedRing&& other) noexcept {
+    *this = std::move(other);
+}
+
+IoTDataSharedRing& IoTDataSharedRing::operator=(IoTDataSharedRing&& other) noexcept {
+    if (this != &other) {
+        if (mapping != nullptr) {
+            ::munmap(mapping, mappingSize);
+        }
+        name = std::move(other.name);
+        owner = other.owner;
+        mapping = other.mapping;
+        mappingSize = other.mappingSize;
+        header = other.header;
+        values = other.values;
+        timestamps = other.timestamps;
+        capacity = other.capacity;
+        readSequence = other.readSequence;
+        lostCount = other.lostCount;
+        other.mapping = nullptr;
+        other.header = nullptr;
+    }
+    return *this;
+}
+
+IoTDataSharedRing::~IoTDataSharedRing() {
+    if (mapping != nullptr) {
+        ::munmap(mapping, mappingSize);
+    }
+}
+
+void IoTDataSharedRing::map(int fd, size_t size, bool writable) {
+    void* address = ::mmap(nullptr, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+    if (address == MAP_FAILED) {
+        throw IoTDataFileException("Error: Unable to map the shared-memory ring.");
+    }
+
+    mapping = address;
+    mappingSize = size;
+    header = static_cast<RingHeader*>(address);
+}
+
+IoTDataSharedRing IoTDataSharedRing::create(const std::string& name, size_t capacity) {
+    if (capacity == 0) {
+        throw IoTDataException("Error: Shared ring capacity must be positive.");
+    }
+
+    // A stale ring is unlinked rather than truncated: truncating an object that readers still map would
+    // fault them (SIGBUS), while an unlinked one stays mapped until they let go of it
+    int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0 && errno == EEXIST && ::shm_unlink(name.c_str()) == 0) {
+        fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    }
+    if (fd < 0) {
+        throw IoTDataFileException("Error: Unable to create the shared-memory ring.");
+    }
+
+    size_t size = sizeof(RingHeader) + 2 * capacity * sizeof(double);
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        ::close(fd);
+        throw IoTDataFileException("Error: Unable to size the shared-memory ring.");
+    }
+
+    IoTDataSharedRing ring(name, true);
+    try {
+        ring.map(fd, size, true);
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+    ::close(fd);
+
+    RingHeader* header = new (ring.mapping) RingHeader;
+    header->capacity = capacity;
+    header->claimSequence.store(0, std::memory_order_relaxed);
+    header->writeSequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(header->magic, kRingMagic, sizeof(kRingMagic));  // Readers accept the ring once the magic is set
+
+    ring.capacity = capacity;
+    ring.values = reinterpret_cast<double*>(static_cast<char*>(ring.mapping) + sizeof(RingHeader));
+    ring.timestamps = ring.values + capacity;
+    return ring;
+}
+
+IoTDataSharedRing IoTDataSharedRing::open(const std::string& name, bool fromOldest) {
+    int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        throw IoTDataFileException("Error: Unable to open the shared-memory ring.");
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(RingHeader)) {
+        ::close(fd);
+        throw IoTDataFileException("Error: Shared-memory ring is not initialized.");
+    }
+
+    IoTDataSharedRing ring(name, false);
+    try {
+        ring.map(fd, static_cast<size_t>(info.st_size), false);
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+    ::close(fd);
+
+    if (std::memcmp(ring.header->magic, kRingMagic, sizeof(kRingMagic)) != 0) {
+        throw IoTDataFileException("Error: Shared-memory object is not an IoTData ring.");
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    ring.capacity = ring.header->capacity;
+    if (sizeof(RingHeader) + 2 * ring.capacity * sizeof(double) != ring.mappingSize) {
+        throw IoTDataFileException("Error: Shared-memory ring has an unexpected size.");
+    }
+
+    ring.values = reinterpret_cast<double*>(static_cast<char*>(ring.mapping) + sizeof(RingHeader));
+    ring.timestamps = ring.values + ring.capacity;
+
+    uint64_t claimed = ring.header->claimSequence.load(std::memory_order_acquire);
+    uint64_t published = ring.header->writeSequence.load(std::memory_order_acquire);
+    ring.readSequence = fromOldest ? (claimed > ring.capacity ? claimed - ring.capacity : 0) : published;
+    return ring;
+}
+
+void IoTDataSharedRing::appendData(double newData, double timestamp) {
+    if (!owner) {
+        throw IoTDataException("Error: Only the ring's creator may append data.");
+    }
+
+    uint64_t sequence = header->writeSequence.load(std::memory_order_relaxed);
+    size_t slot = static_cast<size_t>(sequence % capacity);
+
+    // Announce the overwrite before touching the slot so readers can detect torn reads
+    header->claimSequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    values[slot] = newData;
+    timestamps[slot] = timestamp;
+
+    header->writeSequence.store(sequence + 1, std::memory_order_release);
+}
+
+size_t IoTDataSharedRing::attach(IoTData& series) {
+    // The ring must outlive the series, or the listener must be removed first
+    return series.addAppendListener([this](double value, double timestamp) { appendData(value, timestamp); });
+}
+
+void IoTDataSharedRing::unlink() {
+    ::shm_unlink(name.c_str());
+}
+
+IoTDataRingBatch IoTDataSharedRing::readAvailable(size_t maxPoints) {
+    IoTDataRingBatch batch;
+
+    uint64_t published = header->writeSequence.load(std::memory_order_acquire);
+    uint64_t claimed = header->claimSequence.load(std::memory_order_relaxed);
+
+    // Points the writer has lapped are skipped and counted as lost
+    uint64_t oldest = claimed > capacity ? claimed - capacity : 0;
+    if (readSequence < oldest) {
+        lostCount += oldest - readSequence;
+        readSequence = oldest;
+    }
+
+    uint64_t count = std::min<uint64_t>(published > readSequence ? published - readSequence : 0, maxPoints);
+    batch.firstSequence = readSequence;
+    batch.count = count;
+
+    size_t start = static_cast<size_t>(readSequence % capacity);
+    size_t firstLength = static_cast<size_t>(std::min<uint64_t>(count, capacity - start));
+    if (firstLength > 0) {
+        batch.segments[batch.segmentCount++] = IoTDataView(values + start, timestamps + start, firstLength);
+    }
+    if (count > firstLength) {
+        batch.segments[batch.segmentCount++] = IoTDataView(values, timestamps, static_cast<size_t>(count - firstLength));
+    }
+
+    readSequence += count;
+    return batch;
+}
+
+bool IoTDataSharedRing::isIntact(const IoTDataRingBatch& batch) const {
+    // Seqlock-style validation: the reads of the batch happen before this load
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t claimed = header->claimSequence.load(std::memory_order_relaxed);
+    return batch.count == 0 || claimed <= batch.firstSequence + capacity;
+}
+
+size_t IoTDataSharedRing::readInto(IoTData& target, size_t maxPoints) {
+    IoTDataRingBatch batch = readAvailable(maxPoints);
+
+    std::vector<double> copiedValues;
+    std::vector<double> copiedTimestamps;
+    copiedValues.reserve(batch.count);
+    copiedTimestamps.reserve(batch.count);
+    for (size_t s = 0; s < batch.segmentCount; ++s) {
+        const IoTDataView& segment = batch.segments[s];
+        copiedValues.insert(copiedValues.end(), segment.values(), segment.values() + segment.size());
+        copiedTimestamps.insert(copiedTimestamps.end(), segment.timestamps(), segment.timestamps() + segment.size());
+    }
+
+    // Drop the prefix the writer may have overwritten while it was being copied
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t claimed = header->claimSequence.load(std::memory_order_relaxed);
+    uint64_t overwritten = claimed > batch.firstSequence + capacity ? claimed - batch.firstSequence - capacity : 0;
+    size_t skip = static_cast<size_t>(std::min<uint64_t>(overwritten, batch.count));
+    lostCount += skip;
+
+    for (size_t i = skip; i < copiedValues.size(); ++i) {
+        target.appendData(copiedValues[i], copiedTimestamps[i]);
+    }
+    return copiedValues.size() - skip;
+}
+
+uint64_t IoTDataSharedRing::getWriteSequence() const {
+    return header->writeSequence.load(std::memory_order_acquire);
+}
+
+uint64_t IoTDataSharedRing::getLostCount() const {
+    return lostCount;
+}
+
+size_t IoTDataSharedRing::getCapacity() const {
+    return static_cast<size_t>(capacity);
+}
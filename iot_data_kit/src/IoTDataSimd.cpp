@@ -0,0 +1,641 @@
+// IoTDataSimd.cpp
+#include "IoTDataSimd.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define IOT_DATA_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace IoTDataSimd {
+
+namespace {
+
+void rangeMaskScalar(const double* column, size_t count, double lower, double upper, uint64_t* mask) {
+    size_t wordCount = (count + 63) / 64;
+    for (size_t w = 0; w < wordCount; ++w) {
+        size_t begin = w * 64;
+        size_t end = begin + 64 < count ? begin + 64 : count;
+        uint64_t bits = 0;
+        for (size_t i = begin; i < end; ++i) {
+            bits |= static_cast<uint64_t>(column[i] >= lower && column[i] <= upper) << (i - begin);
+        }
+        mask[w] = bits;
+    }
+}
+
+double sumScalar(const double* column, size_t count) {
+    double total = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        total += column[i];
+    }
+    return total;
+}
+
+double sumSquaredDeviationsScalar(const double* column, size_t count, double mean) {
+    double total = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        double difference = column[i] - mean;
+        total += difference * difference;
+    }
+    return total;
+}
+
+void shiftedSumsScalar(const double* column, size_t count, double shift, double& sum, double& sumSquares) {
+    double total = 0.0;
+    double totalSquares = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        double d = column[i] - shift;
+        total += d;
+        totalSquares += d * d;
+    }
+    sum = total;
+    sumSquares = totalSquares;
+}
+
+// Neumaier step: sum += value with the rounding error of the addition collected in compensation
+inline void neumaierAdd(double& sum, double& compensation, double value) {
+    double total = sum + value;
+    compensation += std::fabs(sum) >= std::fabs(value) ? (sum - total) + value : (value - total) + sum;
+    sum = total;
+}
+
+double compensatedSumScalar(const double* column, size_t count) {
+    double total = 0.0;
+    double compensation = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        neumaierAdd(total, compensation, column[i]);
+    }
+    return total + compensation;
+}
+
+void compensatedShiftedSumsScalar(const double* column, size_t count, double shift, double& sum,
+                                  double& sumSquares) {
+    double total = 0.0, compensation = 0.0;
+    double totalSquares = 0.0, compensationSquares = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        double d = column[i] - shift;
+        neumaierAdd(total, compensation, d);
+        neumaierAdd(totalSquares, compensationSquares, d * d);
+    }
+    sum = total + compensation;
+    sumSquares = totalSquares + compensationSquares;
+}
+
+void prefixSumTicksScalar(int64_t* ticks, size_t count, double scale, double* output, int64_t carry = 0) {
+    for (size_t i = 0; i < count; ++i) {
+        carry += ticks[i];
+        ticks[i] = carry;
+        output[i] = static_cast<double>(carry) / scale;
+    }
+}
+
+bool minMaxScalar(const double* column, size_t count, double& minimum, double& maximum) {
+    double low = column[0];
+    double high = column[0];
+    bool ordered = !std::isnan(column[0]);
+    for (size_t i = 1; i < count; ++i) {
+        double value = column[i];
+        ordered = ordered && !std::isnan(value);
+        low = value < low ? value : low;
+        high = value > high ? value : high;
+    }
+    minimum = low;
+    maximum = high;
+    return ordered;
+}
+
+double dotProductScalar(const double* a, const double* b, size_t count) {
+    double total = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        total += a[i] * b[i];
+    }
+    return total;
+}
+
+void magnitudeScalar(const double* const* columns, size_t channelCount, size_t count, double* output) {
+    for (size_t i = 0; i < count; ++i) {
+        double total = 0.0;
+        for (size_t c = 0; c < channelCount; ++c) {
+            total += columns[c][i] * columns[c][i];
+        }
+        output[i] = std::sqrt(total);
+    }
+}
+
+void weightedSumScalar(const double* const* columns, const double* weights, size_t channelCount, size_t count,
+                       double* output) {
+    for (size_t i = 0; i < count; ++i) {
+        double total = 0.0;
+        for (size_t c = 0; c < channelCount; ++c) {
+            total += weights[c] * columns[c][i];
+        }
+        output[i] = total;
+    }
+}
+
+void polynomialScalar(const double* input, size_t count, const double* coefficients, size_t coefficientCount,
+                      double* output) {
+    for (size_t i = 0; i < count; ++i) {
+        double x = input[i];
+        double result = coefficients[coefficientCount - 1];
+        for (size_t k = coefficientCount - 1; k > 0; --k) {
+            result = result * x + coefficients[k - 1];
+        }
+        output[i] = result;
+    }
+}
+
+void uniformLookupScalar(const double* input, size_t count, double first, double step, const double* table,
+                         size_t tableSize, double* output) {
+    double inverseStep = 1.0 / step;
+    double last = static_cast<double>(tableSize - 1);
+    for (size_t i = 0; i < count; ++i) {
+        double x = input[i];
+        if (std::isnan(x)) {
+            output[i] = x;
+            continue;
+        }
+        double position = std::min(std::max((x - first) * inverseStep, 0.0), last);
+        size_t index = std::min(static_cast<size_t>(position), tableSize - 2);
+        double fraction = position - static_cast<double>(index);
+        output[i] = table[index] + fraction * (table[index + 1] - table[index]);
+    }
+}
+
+#ifdef IOT_DATA_SIMD_X86
+__attribute__((target("avx2")))
+void rangeMaskAvx2(const double* column, size_t count, double lower, double upper, uint64_t* mask) {
+    const __m256d lo = _mm256_set1_pd(lower);
+    const __m256d hi = _mm256_set1_pd(upper);
+    size_t fullWords = count / 64;
+
+    for (size_t w = 0; w < fullWords; ++w) {
+        const double* block = column + w * 64;
+        uint64_t bits = 0;
+        for (size_t j = 0; j < 64; j += 4) {
+            __m256d v = _mm256_loadu_pd(block + j);
+            __m256d inRange = _mm256_and_pd(_mm256_cmp_pd(v, lo, _CMP_GE_OQ), _mm256_cmp_pd(v, hi, _CMP_LE_OQ));
+            bits |= static_cast<uint64_t>(_mm256_movemask_pd(inRange)) << j;
+        }
+        mask[w] = bits;
+    }
+
+    if (count % 64 != 0) {
+        rangeMaskScalar(column + fullWords * 64, count % 64, lower, upper, mask + fullWords);
+    }
+}
+
+__attribute__((target("avx2")))
+double horizontalSum(__m256d v) {
+    __m128d pair = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+}
+
+// Reductions keep four independent accumulators to hide the add latency
+__attribute__((target("avx2")))
+double sumAvx2(const double* column, size_t count) {
+    __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+    __m256d acc2 = _mm256_setzero_pd(), acc3 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(column + i));
+        acc1 = _mm256_add_pd(acc1, _mm256_loadu_pd(column + i + 4));
+        acc2 = _mm256_add_pd(acc2, _mm256_loadu_pd(column + i + 8));
+        acc3 = _mm256_add_pd(acc3, _mm256_loadu_pd(column + i + 12));
+    }
+    for (; i + 4 <= count; i += 4) {
+        acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(column + i));
+    }
+    double total = horizontalSum(_mm256_add_pd(_mm256_add_pd(acc0, acc1), _mm256_add_pd(acc2, acc3)));
+    return total + sumScalar(column + i, count - i);
+}
+
+__attribute__((target("avx2,fma")))
+double sumSquaredDeviationsAvx2(const double* column, size_t count, double mean) {
+    const __m256d center = _mm256_set1_pd(mean);
+    __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+    __m256d acc2 = _mm256_setzero_pd(), acc3 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256d d0 = _mm256_sub_pd(_mm256_loadu_pd(column + i), center);
+        __m256d d1 = _mm256_sub_pd(_mm256_loadu_pd(column + i + 4), center);
+        __m256d d2 = _mm256_sub_pd(_mm256_loadu_pd(column + i + 8), center);
+        __m256d d3 = _mm256_sub_pd(_mm256_loadu_pd(column + i + 12), center);
+        acc0 = _mm256_fmadd_pd(d0, d0, acc0);
+        acc1 = _mm256_fmadd_pd(d1, d1, acc1);
+        acc2 = _mm256_fmadd_pd(d2, d2, acc2);
+        acc3 = _mm256_fmadd_pd(d3, d3, acc3);
+    }
+    for (; i + 4 <= count; i += 4) {
+        __m256d d = _mm256_sub_pd(_mm256_loadu_pd(column + i), center);
+        acc0 = _mm256_fmadd_pd(d, d, acc0);
+    }
+    double total = horizontalSum(_mm256_add_pd(_mm256_add_pd(acc0, acc1), _mm256_add_pd(acc2, acc3)));
+    return total + sumSquaredDeviationsScalar(column + i, count - i, mean);
+}
+
+__attribute__((target("avx2,fma")))
+void shiftedSumsAvx2(const double* column, size_t count, double shift, double& sum, double& sumSquares) {
+    const __m256d center = _mm256_set1_pd(shift);
+    __m256d sum0 = _mm256_setzero_pd(), sum1 = _mm256_setzero_pd();
+    __m256d squares0 = _mm256_setzero_pd(), squares1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256d d0 = _mm256_sub_pd(_mm256_loadu_pd(column + i), center);
+        __m256d d1 = _mm256_sub_pd(_mm256_loadu_pd(column + i + 4), center);
+        sum0 = _mm256_add_pd(sum0, d0);
+        sum1 = _mm256_add_pd(sum1, d1);
+        squares0 = _mm256_fmadd_pd(d0, d0, squares0);
+        squares1 = _mm256_fmadd_pd(d1, d1, squares1);
+    }
+    double tailSum;
+    double tailSquares;
+    shiftedSumsScalar(column + i, count - i, shift, tailSum, tailSquares);
+    sum = horizontalSum(_mm256_add_pd(sum0, sum1)) + tailSum;
+    sumSquares = horizontalSum(_mm256_add_pd(squares0, squares1)) + tailSquares;
+}
+
+// Lane-wise Neumaier step; the compensation update is off the critical path of the running sum
+__attribute__((target("avx2")))
+inline void neumaierAddAvx2(__m256d& sum, __m256d& compensation, __m256d value) {
+    const __m256d absMask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7FFFFFFFFFFFFFFFLL));
+    __m256d total = _mm256_add_pd(sum, value);
+    __m256d sumLarger = _mm256_cmp_pd(_mm256_and_pd(sum, absMask), _mm256_and_pd(value, absMask), _CMP_GE_OQ);
+    __m256d larger = _mm256_blendv_pd(value, sum, sumLarger);
+    __m256d smaller = _mm256_blendv_pd(sum, value, sumLarger);
+    compensation = _mm256_add_pd(compensation, _mm256_add_pd(_mm256_sub_pd(larger, total), smaller));
+    sum = total;
+}
+
+// Folds the lanes of two sum/compensation pairs into one scalar pair, still compensated
+__attribute__((target("avx2")))
+void neumaierReduceAvx2(__m256d sum0, __m256d compensation0, __m256d sum1, __m256d compensation1,
+                        double& total, double& compensation) {
+    double sums[8];
+    _mm256_storeu_pd(sums, sum0);
+    _mm256_storeu_pd(sums + 4, sum1);
+    compensation = horizontalSum(_mm256_add_pd(compensation0, compensation1));
+    total = 0.0;
+    for (double value : sums) {
+        neumaierAdd(total, compensation, value);
+    }
+}
+
+__attribute__((target("avx2")))
+double compensatedSumAvx2(const double* column, size_t count) {
+    __m256d sum0 = _mm256_setzero_pd(), sum1 = _mm256_setzero_pd();
+    __m256d compensation0 = _mm256_setzero_pd(), compensation1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        neumaierAddAvx2(sum0, compensation0, _mm256_loadu_pd(column + i));
+        neumaierAddAvx2(sum1, compensation1, _mm256_loadu_pd(column + i + 4));
+    }
+    double total;
+    double compensation;
+    neumaierReduceAvx2(sum0, compensation0, sum1, compensation1, total, compensation);
+    for (; i < count; ++i) {
+        neumaierAdd(total, compensation, column[i]);
+    }
+    return total + compensation;
+}
+
+__attribute__((target("avx2")))
+void compensatedShiftedSumsAvx2(const double* column, size_t count, double shift, double& sum,
+                                double& sumSquares) {
+    const __m256d center = _mm256_set1_pd(shift);
+    __m256d sum0 = _mm256_setzero_pd(), sum1 = _mm256_setzero_pd();
+    __m256d compensation0 = _mm256_setzero_pd(), compensation1 = _mm256_setzero_pd();
+    __m256d squares0 = _mm256_setzero_pd(), squares1 = _mm256_setzero_pd();
+    __m256d squaresCompensation0 = _mm256_setzero_pd(), squaresCompensation1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256d d0 = _mm256_sub_pd(_mm256_loadu_pd(column + i), center);
+        __m256d d1 = _mm256_sub_pd(_mm256_loadu_pd(column + i + 4), center);
+        neumaierAddAvx2(sum0, compensation0, d0);
+        neumaierAddAvx2(sum1, compensation1, d1);
+        neumaierAddAvx2(squares0, squaresCompensation0, _mm256_mul_pd(d0, d0));
+        neumaierAddAvx2(squares1, squaresCompensation1, _mm256_mul_pd(d1, d1));
+    }
+    double total, compensation, totalSquares, compensationSquares;
+    neumaierReduceAvx2(sum0, compensation0, sum1, compensation1, total, compensation);
+    neumaierReduceAvx2(squares0, squaresCompensation0, squares1, squaresCompensation1, totalSquares,
+                       compensationSquares);
+    for (; i < count; ++i) {
+        double d = column[i] - shift;
+        neumaierAdd(total, compensation, d);
+        neumaierAdd(totalSquares, compensationSquares, d * d);
+    }
+    sum = total + compensation;
+    sumSquares = totalSquares + compensationSquares;
+}
+
+// Four-lane scan (shift by one, then two lanes) plus the running carry; int64 -> double uses the
+// 2^52 + 2^51 magic constant since AVX2 has no packed conversion
+__attribute__((target("avx2")))
+void prefixSumTicksAvx2(int64_t* ticks, size_t count, double scale, double* output) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i magicInteger = _mm256_set1_epi64x(0x4338000000000000LL);
+    const __m256d magic = _mm256_set1_pd(6755399441055744.0);
+    const __m256d divisor = _mm256_set1_pd(scale);
+    __m256i carry = zero;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ticks + i));
+        x = _mm256_add_epi64(x, _mm256_blend_epi32(_mm256_permute4x64_epi64(x, 0x90), zero, 0x03));
+        x = _mm256_add_epi64(x, _mm256_blend_epi32(_mm256_permute4x64_epi64(x, 0x40), zero, 0x0F));
+        x = _mm256_add_epi64(x, carry);
+        carry = _mm256_permute4x64_epi64(x, 0xFF);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(ticks + i), x);
+        __m256d converted = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_add_epi64(x, magicInteger)), magic);
+        _mm256_storeu_pd(output + i, _mm256_div_pd(converted, divisor));
+    }
+    int64_t tail = i > 0 ? ticks[i - 1] : 0;
+    prefixSumTicksScalar(ticks + i, count - i, scale, output + i, tail);
+}
+
+__attribute__((target("avx2")))
+bool minMaxAvx2(const double* column, size_t count, double& minimum, double& maximum) {
+    if (count < 4) {
+        return minMaxScalar(column, count, minimum, maximum);
+    }
+
+    __m256d low = _mm256_loadu_pd(column);
+    __m256d high = low;
+    __m256d unordered = _mm256_cmp_pd(low, low, _CMP_UNORD_Q);
+    size_t i = 4;
+    for (; i + 4 <= count; i += 4) {
+        __m256d v = _mm256_loadu_pd(column + i);
+        low = _mm256_min_pd(low, v);
+        high = _mm256_max_pd(high, v);
+        unordered = _mm256_or_pd(unordered, _mm256_cmp_pd(v, v, _CMP_UNORD_Q));
+    }
+
+    double lanes[4];
+    _mm256_storeu_pd(lanes, low);
+    double tailLow = std::min(std::min(lanes[0], lanes[1]), std::min(lanes[2], lanes[3]));
+    _mm256_storeu_pd(lanes, high);
+    double tailHigh = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+    bool ordered = _mm256_movemask_pd(unordered) == 0;
+    for (; i < count; ++i) {
+        double value = column[i];
+        ordered = ordered && !std::isnan(value);
+        tailLow = value < tailLow ? value : tailLow;
+        tailHigh = value > tailHigh ? value : tailHigh;
+    }
+    minimum = tailLow;
+    maximum = tailHigh;
+    return ordered;
+}
+
+__attribute__((target("avx2,fma")))
+double dotProductAvx2(const double* a, const double* b, size_t count) {
+    __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+    __m256d acc2 = _mm256_setzero_pd(), acc3 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), acc0);
+        acc1 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4), acc1);
+        acc2 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 8), _mm256_loadu_pd(b + i + 8), acc2);
+        acc3 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 12), _mm256_loadu_pd(b + i + 12), acc3);
+    }
+    for (; i + 4 <= count; i += 4) {
+        acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), acc0);
+    }
+    double total = horizontalSum(_mm256_add_pd(_mm256_add_pd(acc0, acc1), _mm256_add_pd(acc2, acc3)));
+    return total + dotProductScalar(a + i, b + i, count - i);
+}
+
+// Cross-channel kernels vectorize along the shared time index, four timestamps per step
+__attribute__((target("avx2,fma")))
+void magnitudeAvx2(const double* const* columns, size_t channelCount, size_t count, double* output) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d total = _mm256_setzero_pd();
+        for (size_t c = 0; c < channelCount; ++c) {
+            __m256d v = _mm256_loadu_pd(columns[c] + i);
+            total = _mm256_fmadd_pd(v, v, total);
+        }
+        _mm256_storeu_pd(output + i, _mm256_sqrt_pd(total));
+    }
+    for (; i < count; ++i) {
+        double total = 0.0;
+        for (size_t c = 0; c < channelCount; ++c) {
+            total += columns[c][i] * columns[c][i];
+        }
+        output[i] = std::sqrt(total);
+    }
+}
+
+__attribute__((target("avx2,fma")))
+void weightedSumAvx2(const double* const* columns, const double* weights, size_t channelCount, size_t count,
+                     double* output) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d total = _mm256_setzero_pd();
+        for (size_t c = 0; c < channelCount; ++c) {
+            total = _mm256_fmadd_pd(_mm256_set1_pd(weights[c]), _mm256_loadu_pd(columns[c] + i), total);
+        }
+        _mm256_storeu_pd(output + i, total);
+    }
+    for (; i < count; ++i) {
+        double total = 0.0;
+        for (size_t c = 0; c < channelCount; ++c) {
+            total += weights[c] * columns[c][i];
+        }
+        output[i] = total;
+    }
+}
+
+__attribute__((target("avx2,fma")))
+void polynomialAvx2(const double* input, size_t count, const double* coefficients, size_t coefficientCount,
+                    double* output) {
+    const __m256d leading = _mm256_set1_pd(coefficients[coefficientCount - 1]);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d x = _mm256_loadu_pd(input + i);
+        __m256d result = leading;
+        for (size_t k = coefficientCount - 1; k > 0; --k) {
+            result = _mm256_fmadd_pd(result, x, _mm256_set1_pd(coefficients[k - 1]));
+        }
+        _mm256_storeu_pd(output + i, result);
+    }
+    polynomialScalar(input + i, count - i, coefficients, coefficientCount, output + i);
+}
+
+__attribute__((target("avx2,fma")))
+void uniformLookupAvx2(const double* input, size_t count, double first, double step, const double* table,
+                       size_t tableSize, double* output) {
+    const __m256d origin = _mm256_set1_pd(first);
+    const __m256d inverseStep = _mm256_set1_pd(1.0 / step);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d last = _mm256_set1_pd(static_cast<double>(tableSize - 1));
+    const __m256d lastSegment = _mm256_set1_pd(static_cast<double>(tableSize - 2));
+    const __m256d allLanes = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d x = _mm256_loadu_pd(input + i);
+        __m256d position = _mm256_mul_pd(_mm256_sub_pd(x, origin), inverseStep);
+        position = _mm256_min_pd(_mm256_max_pd(position, zero), last);
+        __m256d segment = _mm256_min_pd(_mm256_floor_pd(position), lastSegment);
+        __m128i index = _mm256_cvttpd_epi32(segment);
+        __m256d lower = _mm256_mask_i32gather_pd(zero, table, index, allLanes, 8);
+        __m256d upper = _mm256_mask_i32gather_pd(zero, table + 1, index, allLanes, 8);
+        __m256d result = _mm256_fmadd_pd(_mm256_sub_pd(position, segment), _mm256_sub_pd(upper, lower), lower);
+        // max/min above turn NaN into a table value; put the NaN back
+        _mm256_storeu_pd(output + i, _mm256_blendv_pd(result, x, _mm256_cmp_pd(x, x, _CMP_UNORD_Q)));
+    }
+    uniformLookupScalar(input + i, count - i, first, step, table, tableSize, output + i);
+}
+#endif
+
+} // namespace
+
+bool hasAvx2() {
+#ifdef IOT_DATA_SIMD_X86
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+bool hasFma() {
+#ifdef IOT_DATA_SIMD_X86
+    static const bool supported = __builtin_cpu_supports("fma");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+void rangeMask(const double* column, size_t count, double lower, double upper, uint64_t* mask) {
+#ifdef IOT_DATA_SIMD_X86
+    if (hasAvx2()) {
+        rangeMaskAvx2(column, count, lower, upper, mask);
+        return;
+    }
+#endif
+    rangeMaskScalar(column, count, lower, upper, mask);
+}
+
+double sum(const double* column, size_t count) {
+#ifdef IOT_DATA_SIMD_X86
+    if (hasAvx2()) {
+        return sumAvx2(column, count);
+    }
+#endif
+    return sumScalar(column, count);
+}
+
+double sumSquaredDeviations(const double* column, size_t count, double mean) {
+#ifdef IOT_DATA_SIMD_X86
+    if (hasAvx2() && hasFma()) {
+        return sumSquaredDeviationsAvx2(column, count, mean);
+    }
+#endif
+    return sumSquaredDeviationsScalar(column, count, mean);
+}
+
+void shiftedSums(const double* column, size_t count, double shift, double& sum, double& sumSquares) {
+#ifdef IOT_DATA_SIMD_X86
+    if (hasAvx2() && hasFma()) {
+        shiftedSumsAvx2(column, count, shift, sum, sumSquares);
+        return;
+    }
+#endif
+    shiftedSumsScalar(column, count, shift, sum, sumSquares);
+}
+
+double compensatedSum(const double* column, size_t count) {
+#ifdef IOT_DATA_SIMD_X86
+    if (hasAvx2()) {
+        return compensatedSumAvx2(column, count);
+    }
+#endif
+    return compensatedSumScalar(column, count);
+}
+
+void compensatedShiftedSums(const double* column, size_t count, double shift, double& sum, double& sumSquares) {
+#ifdef IOT_DATA_SIMD_X86
+    if (hasAvx2()) {
+        compensatedShiftedSumsAvx2(column, count, shift, sum, sumSquares);
+        return;
+    }
+#endif
+    compensatedShiftedSumsScalar(column, count, shift, sum, sumSquares);
+}
+
+void prefixSumTicks(int64_t* ticks, size_t count, double scale, double* output) {
+#ifdef IOT_DATA_SIMD_X86
+    if (hasAvx2()) {
+        prefixSumTicksAvx2(ticks, count, scale, output);
+        return;
+    }
+#endif
+    prefixSumTicksScalar(ticks, count, scale, output);
+}
+
+bool minMax(const double* column, size_t count, double& minimum, double& maximum) {
+#ifdef IOT_DATA_SIMD_X86
+    if (hasAvx2()) {
+        return minMaxAvx2(column, count, minimum, maximum);
+    }
+#endif
+    return minMaxScalar(column, count, minimum, maximum);
+}
+
+double dotProduct(const double* a, const double* b, size_t count) {
+#ifdef IOT_DATA_SIMD_X86
+    if (hasAvx2() && hasFma()) {
+        return dotProductAvx2(a, b, count);
+    }
+#endif
+    return dotProductScalar(a, b, count);
+}
+
+void magnitude(const double* const* columns, size_t channelCount, size_t count, double* output) {
+#ifdef IOT_DATA_SIMD_X86
+    if (hasAvx2() && hasFma()) {
+        magnitudeAvx2(columns, channelCount, count, output);
+        return;
+    }
+#endif
+    magnitudeScalar(columns, channelCount, count, output);
+}
+
+void weightedSum(const double* const* columns, const double* weights, size_t channelCount, size_t count,
+                 double* output) {
+#ifdef IOT_DATA_SIMD_X86
+    if (hasAvx2() && hasFma()) {
+        weightedSumAvx2(columns, weights, channelCount, count, output);
+        return;
+    }
+#endif
+    weightedSumScalar(columns, weights, channelCount, count, output);
+}
+
+void polynomial(const double* input, size_t count, const double* coefficients, size_t coefficientCount,
+                double* output) {
+#ifdef IOT_DATA_SIMD_X86
+    if (hasAvx2() && hasFma()) {
+        polynomialAvx2(input, count, coefficients, coefficientCount, output);
+        return;
+    }
+#endif
+    polynomialScalar(input, count, coefficients, coefficientCount, output);
+}
+
+void uniformLookup(const double* input, size_t count, double first, double step, const double* table,
+                   size_t tableSize, double* output) {
+#ifdef IOT_DATA_SIMD_X86
+    if (hasAvx2() && hasFma()) {
+        uniformLookupAvx2(input, count, first, step, table, tableSize, output);
+        return;
+    }
+#endif
+    uniformLookupScalar(input, count, first, step, table, tableSize, output);
+}
+
+} // namespace IoTDataSimd
@@ -0,0 +1,63 @@
+// IoTDataSimd.h
+// Internal vectorized kernels with runtime dispatch between AVX2 and portable code.
+#ifndef IOT_DATA_SIMD_H
+#define IOT_DATA_SIMD_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace IoTDataSimd {
+
+// True when the running CPU supports the AVX2 kernels
+bool hasAvx2();
+
+// True when the running CPU supports fused multiply-add (paired with AVX2 in the arithmetic kernels)
+bool hasFma();
+
+// Sets bit i of mask when lower <= column[i] <= upper (NaN never matches).
+// mask must hold (count + 63) / 64 words; bits past count are cleared.
+void rangeMask(const double* column, size_t count, double lower, double upper, uint64_t* mask);
+
+// Sum of column[0..count)
+double sum(const double* column, size_t count);
+
+// Sum of (column[i] - mean)^2
+double sumSquaredDeviations(const double* column, size_t count, double mean);
+
+// One pass over the column: sum and sum of squares of (column[i] - shift)
+void shiftedSums(const double* column, size_t count, double shift, double& sum, double& sumSquares);
+
+// Compensated (Kahan-Babuska / Neumaier) counterparts of sum and shiftedSums: every lane carries its
+// rounding error, so the result stays accurate for long columns with large offsets at SIMD width
+double compensatedSum(const double* column, size_t count);
+void compensatedShiftedSums(const double* column, size_t count, double shift, double& sum, double& sumSquares);
+
+// Minimum and maximum of a non-empty column; returns false when the column contains NaN
+bool minMax(const double* column, size_t count, double& minimum, double& maximum);
+
+// Sum of a[i] * b[i]
+double dotProduct(const double* a, const double* b, size_t count);
+
+// output[i] = sqrt(sum over c of columns[c][i]^2)
+void magnitude(const double* const* columns, size_t channelCount, size_t count, double* output);
+
+// output[i] = sum over c of weights[c] * columns[c][i]
+void weightedSum(const double* const* columns, const double* weights, size_t channelCount, size_t count,
+                 double* output);
+
+// output[i] = c[0] + c[1] * input[i] + ... evaluated with Horner's rule; input and output may alias
+void polynomial(const double* input, size_t count, const double* coefficients, size_t coefficientCount,
+                double* output);
+
+// Piecewise-linear lookup in a table sampled at first + k * step (tableSize >= 2), clamped to the
+// end values; NaN stays NaN. input and output may alias.
+void uniformLookup(const double* input, size_t count, double first, double step, const double* table,
+                   size_t tableSize, double* output);
+
+// Inclusive prefix sum of ticks in place, with output[i] = ticks[i] / scale. Every partial sum must stay
+// within +-2^51 so the int64 -> double conversion is exact.
+void prefixSumTicks(int64_t* ticks, size_t count, double scale, double* output);
+
+} // namespace IoTDataSimd
+
+#endif // IOT_DATA_SIMD_H
@@ -0,0 +1,462 @@
+// IoTDataSketch.cpp
+#include "IoTDataSketch.h"
+#include "IoTDataException.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+uint64_t splitMix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// Bit pattern identifying a discrete value (-0.0 and 0.0 are the same reading)
+uint64_t valueKey(double value) {
+    if (value == 0.0) {
+        value = 0.0;
+    }
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+constexpr char kSketchMagic[4] = {'I', 'C', 'M', '1'};
+constexpr size_t kSketchHeaderSize = sizeof(kSketchMagic) + 4 * sizeof(uint64_t);
+
+constexpr char kBloomMagic[4] = {'I', 'B', 'F', '1'};
+constexpr size_t kBloomHeaderSize = sizeof(kBloomMagic) + 3 * sizeof(uint64_t);
+constexpr size_t kMaxBloomHashCount = 64;  // Enough for false positive rates far below 1e-15
+
+// floor(timestamp / width) clamped to the int64_t range; the cast alone is undefined beyond it
+// Bucket id of a slot that holds nothing yet: below every id add produces, so any point may take the slot
+constexpr int64_t kUnusedBucket = std::numeric_limits<int64_t>::min();
+
+int64_t clampedBucket(double timestamp, double width) {
+    constexpr double kLimit = 9223372036854775808.0;  // 2^63
+    double bucket = std::floor(timestamp / width);
+    if (bucket >= kLimit) {
+        return std::numeric_limits<int64_t>::max();
+    }
+    return bucket < -kLimit ? std::numeric_limits<int64_t>::min() : static_cast<int64_t>(bucket);
+}
+
+// FNV-1a over the key bytes, finished with splitMix64 for well-mixed high bits
+uint64_t stringKey(const std::string& key, uint64_t seed) {
+    uint64_t hash = 0xCBF29CE484222325ULL ^ seed;
+    for (unsigned char c : key) {
+        hash = (hash ^ c) * 0x100000001B3ULL;
+    }
+    return splitMix64(hash);
+}
+
+} // namespace
+
+IoTDataCountMinSketch::IoTDataCountMinSketch(size_t width, size_t depth, uint64_t seed)
+    : width(width), depth(depth), seed(seed), counters(width * depth, 0) {
+    if (width == 0 || depth == 0) {
+        throw IoTDataException("Error: Count-min sketch dimensions must be positive.");
+    }
+}
+
+IoTDataCountMinSketch IoTDataCountMinSketch::fromErrorBounds(double epsilon, double delta, uint64_t seed) {
+    if (!(epsilon > 0.0 && epsilon < 1.0) || !(delta > 0.0 && delta < 1.0)) {
+        throw IoTDataException("Error: Count-min sketch error bounds must be between 0 and 1.");
+    }
+
+    size_t width = static_cast<size_t>(std::ceil(std::exp(1.0) / epsilon));
+    size_t depth = static_cast<size_t>(std::ceil(std::log(1.0 / delta)));
+    return IoTDataCountMinSketch(width, std::max<size_t>(depth, 1), seed);
+}
+
+size_t IoTDataCountMinSketch::cell(size_t row, uint64_t hash1, uint64_t hash2) const {
+    // Kirsch-Mitzenmacher double hashing gives independent-enough rows from two hashes
+    uint64_t hash = hash1 + row * hash2;
+    return row * width + static_cast<size_t>(hash % width);
+}
+
+void IoTDataCountMinSketch::add(double value, uint64_t count) {
+    uint64_t hash1 = splitMix64(valueKey(value) ^ seed);
+    uint64_t hash2 = splitMix64(hash1) | 1;
+    for (size_t row = 0; row < depth; ++row) {
+        counters[cell(row, hash1, hash2)] += count;
+    }
+    totalCount += count;
+}
+
+uint64_t IoTDataCountMinSketch::estimate(double value) const {
+    uint64_t hash1 = splitMix64(valueKey(value) ^ seed);
+    uint64_t hash2 = splitMix64(hash1) | 1;
+    uint64_t result = std::numeric_limits<uint64_t>::max();
+    for (size_t row = 0; row < depth; ++row) {
+        result = std::min(result, counters[cell(row, hash1, hash2)]);
+    }
+    return result;
+}
+
+uint64_t IoTDataCountMinSketch::getTotalCount() const {
+    return totalCount;
+}
+
+void IoTDataCountMinSketch::merge(const IoTDataCountMinSketch& other) {
+    if (other.width != width || other.depth != depth || other.seed != seed) {
+        throw IoTDataException("Error: Count-min sketches must share dimensions and seed to be merged.");
+    }
+
+    for (size_t i = 0; i < counters.size(); ++i) {
+        counters[i] += other.counters[i];
+    }
+    totalCount += other.totalCount;
+}
+
+void IoTDataCountMinSketch::clear() {
+    std::fill(counters.begin(), counters.end(), 0);
+    totalCount = 0;
+}
+
+std::vector<uint8_t> IoTDataCountMinSketch::serialize() const {
+    uint64_t header[4] = {width, depth, seed, totalCount};
+    std::vector<uint8_t> bytes(kSketchHeaderSize + counters.size() * sizeof(uint64_t));
+    std::memcpy(bytes.data(), kSketchMagic, sizeof(kSketchMagic));
+    std::memcpy(bytes.data() + sizeof(kSketchMagic), header, sizeof(header));
+    std::memcpy(bytes.data() + kSketchHeaderSize, counters.data(), counters.size() * sizeof(uint64_t));
+    return bytes;
+}
+
+IoTDataCountMinSketch IoTDataCountMinSketch::deserialize(const uint8_t* bytes, size_t size) {
+    if (size < kSketchHeaderSize || std::memcmp(bytes, kSketchMagic, sizeof(kSketchMagic)) != 0) {
+        throw IoTDataException("Error: Invalid serialized count-min sketch.");
+    }
+
+    uint64_t header[4];
+    std::memcpy(header, bytes + sizeof(kSketchMagic), sizeof(header));
+    if (header[0] == 0 || header[1] == 0 || header[0] > (size - kSketchHeaderSize) / sizeof(uint64_t) / header[1] ||
+        size != kSketchHeaderSize + header[0] * header[1] * sizeof(uint64_t)) {
+        throw IoTDataException("Error: Invalid serialized count-min sketch.");
+    }
+
+    IoTDataCountMinSketch sketch(static_cast<size_t>(header[0]), static_cast<size_t>(header[1]), header[2]);
+    sketch.totalCount = header[3];
+    std::memcpy(sketch.counters.data(), bytes + kSketchHeaderSize, sketch.counters.size() * sizeof(uint64_t));
+    return sketch;
+}
+
+size_t IoTDataCountMinSketch::getWidth() const {
+    return width;
+}
+
+size_t IoTDataCountMinSketch::getDepth() const {
+    return depth;
+}
+
+uint64_t IoTDataCountMinSketch::getSeed() const {
+    return seed;
+}
+
+const std::vector<uint64_t>& IoTDataCountMinSketch::getCounters() const {
+    return counters;
+}
+
+IoTDataHeavyHitters::IoTDataHeavyHitters(size_t capacity) : capacity(capacity) {
+    if (capacity == 0) {
+        throw IoTDataException("Error: Heavy hitter capacity must be positive.");
+    }
+    heap.reserve(capacity);
+    positions.reserve(capacity * 2);
+}
+
+void IoTDataHeavyHitters::swapEntries(size_t a, size_t b) {
+    std::swap(heap[a], heap[b]);
+    positions[valueKey(heap[a].value)] = a;
+    positions[valueKey(heap[b].value)] = b;
+}
+
+void IoTDataHeavyHitters::siftUp(size_t index) {
+    while (index > 0) {
+        size_t parent = (index - 1) / 2;
+        if (heap[parent].count <= heap[index].count) {
+            break;
+        }
+        swapEntries(parent, index);
+        index = parent;
+    }
+}
+
+void IoTDataHeavyHitters::siftDown(size_t index) {
+    for (;;) {
+        size_t smallest = index;
+        size_t left = 2 * index + 1;
+        size_t right = left + 1;
+        if (left < heap.size() && heap[left].count < heap[smallest].count) {
+            smallest = left;
+        }
+        if (right < heap.size() && heap[right].count < heap[smallest].count) {
+            smallest = right;
+        }
+        if (smallest == index) {
+            return;
+        }
+        swapEntries(smallest, index);
+        index = smallest;
+    }
+}
+
+void IoTDataHeavyHitters::add(double value, uint64_t count) {
+    uint64_t key = valueKey(value);
+
+    auto it = positions.find(key);
+    if (it != positions.end()) {
+        heap[it->second].count += count;
+        siftDown(it->second);
+        return;
+    }
+
+    if (heap.size() < capacity) {
+        heap.push_back({value, count, 0});
+        positions[key] = heap.size() - 1;
+        siftUp(heap.size() - 1);
+        return;
+    }
+
+    // Evict the minimum counter; the newcomer inherits its count as error
+    Entry& minimum = heap.front();
+    positions.erase(valueKey(minimum.value));
+    minimum.error = minimum.count;
+    minimum.count += count;
+    minimum.value = value;
+    positions[key] = 0;
+    siftDown(0);
+}
+
+std::vector<IoTDataHeavyHitters::Entry> IoTDataHeavyHitters::topK(size_t k) const {
+    std::vector<Entry> entries = heap;
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.count > b.count; });
+    if (entries.size() > k) {
+        entries.resize(k);
+    }
+    return entries;
+}
+
+size_t IoTDataHeavyHitters::getCapacity() const {
+    return capacity;
+}
+
+void IoTDataHeavyHitters::merge(const IoTDataHeavyHitters& other) {
+    uint64_t ownMinimum = heap.size() == capacity ? heap.front().count : 0;
+    uint64_t otherMinimum = other.heap.size() == other.capacity ? other.heap.front().count : 0;
+
+    std::unordered_map<uint64_t, Entry> combined;
+    combined.reserve(heap.size() + other.heap.size());
+    for (const Entry& entry : heap) {
+        combined[valueKey(entry.value)] = {entry.value, entry.count + otherMinimum, entry.error + otherMinimum};
+    }
+    for (const Entry& entry : other.heap) {
+        auto it = combined.find(valueKey(entry.value));
+        if (it == combined.end()) {
+            combined[valueKey(entry.value)] = {entry.value, entry.count + ownMinimum, entry.error + ownMinimum};
+        } else {
+            // Present on both sides: replace the assumed minimum with the actual count
+            it->second.count = it->second.count - otherMinimum + entry.count;
+            it->second.error = it->second.error - otherMinimum + entry.error;
+        }
+    }
+
+    std::vector<Entry> entries;
+    entries.reserve(combined.size());
+    for (const auto& item : combined) {
+        entries.push_back(item.second);
+    }
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.count > b.count; });
+    if (entries.size() > capacity) {
+        entries.resize(capacity);
+    }
+
+    heap.clear();
+    positions.clear();
+    for (const Entry& entry : entries) {
+        heap.push_back(entry);
+        positions[valueKey(entry.value)] = heap.size() - 1;
+        siftUp(heap.size() - 1);
+    }
+}
+
+IoTDataTimeBucketedSketch::IoTDataTimeBucketedSketch(double bucketWidth, size_t bucketCount, size_t width, size_t depth)
+    : bucketWidth(bucketWidth), buckets(bucketCount, IoTDataCountMinSketch(width, depth)),
+      bucketIds(bucketCount, kUnusedBucket) {
+    if (!(bucketWidth > 0.0) || bucketCount == 0) {
+        throw IoTDataException("Error: Time-bucketed sketch needs a positive bucket width and count.");
+    }
+}
+
+void IoTDataTimeBucketedSketch::add(double value, double timestamp, uint64_t count) {
+    // Points without a usable bucket are dropped like points older than the retained history
+    if (!std::isfinite(timestamp)) {
+        return;
+    }
+    int64_t bucketId = clampedBucket(timestamp, bucketWidth);
+    if (bucketId == std::numeric_limits<int64_t>::max() || bucketId == std::numeric_limits<int64_t>::min()) {
+        return;
+    }
+    size_t slot = static_cast<size_t>(((bucketId % static_cast<int64_t>(buckets.size())) + buckets.size()) % buckets.size());
+
+    if (bucketIds[slot] != bucketId) {
+        if (bucketIds[slot] > bucketId) {
+            return;  // Older than the retained history
+        }
+        buckets[slot].clear();
+        bucketIds[slot] = bucketId;
+    }
+
+    buckets[slot].add(value, count);
+}
+
+IoTDataCountMinSketch IoTDataTimeBucketedSketch::rangeSketch(double start, double end) const {
+    IoTDataCountMinSketch result(buckets.front().getWidth(), buckets.front().getDepth(), buckets.front().getSeed());
+    if (std::isnan(start) || std::isnan(end)) {
+        return result;
+    }
+    int64_t first = clampedBucket(start, bucketWidth);
+    int64_t last = clampedBucket(end, bucketWidth);
+
+    for (size_t slot = 0; slot < buckets.size(); ++slot) {
+        if (bucketIds[slot] != kUnusedBucket && bucketIds[slot] >= first && bucketIds[slot] <= last) {
+            result.merge(buckets[slot]);
+        }
+    }
+    return result;
+}
+
+uint64_t IoTDataTimeBucketedSketch::estimate(double value, double start, double end) const {
+    return rangeSketch(start, end).estimate(value);
+}
+
+IoTDataFrequencyTracker::IoTDataFrequencyTracker(double bucketWidth, size_t bucketCount, size_t topKCapacity)
+    : heavyHitters(topKCapacity), timeBuckets(bucketWidth, bucketCount) {}
+
+void IoTDataFrequencyTracker::add(double value, double timestamp) {
+    sketch.add(value);
+    heavyHitters.add(value);
+    timeBuckets.add(value, timestamp);
+}
+
+size_t IoTDataFrequencyTracker::attach(IoTData& series) {
+    // The tracker must outlive the series, or the listener must be removed first
+    return series.addAppendListener([this](double value, double timestamp) { add(value, timestamp); });
+}
+
+uint64_t IoTDataFrequencyTracker::estimateFrequency(double value) const {
+    return sketch.estimate(value);
+}
+
+uint64_t IoTDataFrequencyTracker::estimateFrequency(double value, double start, double end) const {
+    return timeBuckets.estimate(value, start, end);
+}
+
+std::vector<IoTDataHeavyHitters::Entry> IoTDataFrequencyTracker::topK(size_t k) const {
+    return heavyHitters.topK(k);
+}
+
+const IoTDataCountMinSketch& IoTDataFrequencyTracker::getSketch() const {
+    return sketch;
+}
+
+const IoTDataHeavyHitters& IoTDataFrequencyTracker::getHeavyHitters() const {
+    return heavyHitters;
+}
+
+IoTDataBloomFilter::IoTDataBloomFilter(size_t bitCount, size_t hashCount, uint64_t seed)
+    : bitCount(bitCount), hashCount(hashCount), seed(seed), bits((bitCount + 63) / 64, 0) {
+    if (bitCount == 0 || hashCount == 0) {
+        throw IoTDataException("Error: Bloom filter dimensions must be positive.");
+    }
+    if (hashCount > kMaxBloomHashCount) {
+        throw IoTDataException("Error: Bloom filter hash count must not exceed 64.");
+    }
+}
+
+IoTDataBloomFilter IoTDataBloomFilter::fromExpectedCount(size_t count, double falsePositiveRate, uint64_t seed) {
+    if (!(falsePositiveRate > 0.0 && falsePositiveRate < 1.0)) {
+        throw IoTDataException("Error: Bloom filter false positive rate must be between 0 and 1.");
+    }
+
+    // Optimal sizing: m = -n ln p / (ln 2)^2 bits and k = m / n ln 2 hashes
+    double n = static_cast<double>(std::max<size_t>(count, 1));
+    double ln2 = std::log(2.0);
+    size_t bitCount = static_cast<size_t>(std::ceil(-n * std::log(falsePositiveRate) / (ln2 * ln2)));
+    size_t hashCount = static_cast<size_t>(std::round(static_cast<double>(bitCount) / n * ln2));
+    hashCount = std::min(std::max<size_t>(hashCount, 1), kMaxBloomHashCount);
+    return IoTDataBloomFilter(std::max<size_t>(bitCount, 64), hashCount, seed);
+}
+
+void IoTDataBloomFilter::add(const std::string& key) {
+    uint64_t hash1 = stringKey(key, seed);
+    uint64_t hash2 = splitMix64(hash1) | 1;
+    for (size_t i = 0; i < hashCount; ++i) {
+        size_t bit = static_cast<size_t>((hash1 + i * hash2) % bitCount);
+        bits[bit / 64] |= uint64_t(1) << (bit % 64);
+    }
+}
+
+bool IoTDataBloomFilter::mightContain(const std::string& key) const {
+    uint64_t hash1 = stringKey(key, seed);
+    uint64_t hash2 = splitMix64(hash1) | 1;
+    for (size_t i = 0; i < hashCount; ++i) {
+        size_t bit = static_cast<size_t>((hash1 + i * hash2) % bitCount);
+        if ((bits[bit / 64] & (uint64_t(1) << (bit % 64))) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void IoTDataBloomFilter::merge(const IoTDataBloomFilter& other) {
+    if (bitCount != other.bitCount || hashCount != other.hashCount || seed != other.seed) {
+        throw IoTDataException("Error: Bloom filters must share dimensions and seed to merge.");
+    }
+    for (size_t i = 0; i < bits.size(); ++i) {
+        bits[i] |= other.bits[i];
+    }
+}
+
+void IoTDataBloomFilter::clear() {
+    std::fill(bits.begin(), bits.end(), 0);
+}
+
+std::vector<uint8_t> IoTDataBloomFilter::serialize() const {
+    uint64_t header[3] = {bitCount, hashCount, seed};
+    std::vector<uint8_t> bytes(kBloomHeaderSize + bits.size() * sizeof(uint64_t));
+    std::memcpy(bytes.data(), kBloomMagic, sizeof(kBloomMagic));
+    std::memcpy(bytes.data() + sizeof(kBloomMagic), header, sizeof(header));
+    std::memcpy(bytes.data() + kBloomHeaderSize, bits.data(), bits.size() * sizeof(uint64_t));
+    return bytes;
+}
+
+IoTDataBloomFilter IoTDataBloomFilter::deserialize(const uint8_t* bytes, size_t size) {
+    if (size < kBloomHeaderSize || std::memcmp(bytes, kBloomMagic, sizeof(kBloomMagic)) != 0) {
+        throw IoTDataException("Error: Invalid serialized Bloom filter.");
+    }
+
+    uint64_t header[3];
+    std::memcpy(header, bytes + sizeof(kBloomMagic), sizeof(header));
+    size_t wordBytes = size - kBloomHeaderSize;
+    if (header[0] == 0 || header[1] == 0 || header[1] > kMaxBloomHashCount || header[0] > wordBytes * 8 || wordBytes % sizeof(uint64_t) != 0 ||
+        (header[0] + 63) / 64 != wordBytes / sizeof(uint64_t)) {
+        throw IoTDataException("Error: Invalid serialized Bloom filter.");
+    }
+
+    IoTDataBloomFilter filter(static_cast<size_t>(header[0]), static_cast<size_t>(header[1]), header[2]);
+    std::memcpy(filter.bits.data(), bytes + kBloomHeaderSize, filter.bits.size() * sizeof(uint64_t));
+    return filter;
+}
+
+size_t IoTDataBloomFilter::getBitCount() const {
+    return bitCount;
+}
+
+size_t IoTDataBloomFilter::getHashCount() const {
+    return hashCount;
+}
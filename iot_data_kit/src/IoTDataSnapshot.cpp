@@ -0,0 +1,430 @@
+// IoTDataSnapshot.cpp
+#include "IoTDataSnapshot.h"
+#include "IoTDataCalibration.h"
+#include "IoTDataException.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const char kSnapshotMagic[8] = {'I', 'O', 'T', 'S', 'N', 'A', 'P', '1'};
+constexpr uint32_t kSnapshotVersion = 2;          // Version 2 adds the ingest calibration
+constexpr uint32_t kNoCalibration = UINT32_MAX;    // Calibration kind of a series without one
+constexpr uint64_t kHeaderSize = 32;
+constexpr size_t kWriteChunkElements = (size_t(8) << 20) / sizeof(double);
+
+// Header layout: magic[8], version, series count, directory offset, directory size
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t seriesCount;
+    uint64_t directoryOffset;
+    uint64_t directorySize;
+};
+static_assert(sizeof(SnapshotHeader) == kHeaderSize, "Unexpected snapshot header padding");
+
+// One contiguous column range written by a single pwrite
+struct WriteTask {
+    const double* source;
+    size_t count;
+    uint64_t offset;
+};
+
+void writeAll(int fd, const void* buffer, size_t size, uint64_t offset) {
+    const char* cursor = static_cast<const char*>(buffer);
+    while (size > 0) {
+        ssize_t written = ::pwrite(fd, cursor, size, static_cast<off_t>(offset));
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw IoTDataFileException("Error: Unable to write snapshot data.");
+        }
+        cursor += written;
+        offset += static_cast<uint64_t>(written);
+        size -= static_cast<size_t>(written);
+    }
+}
+
+template <typename T>
+void appendValue(std::vector<unsigned char>& buffer, T value) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+T readValue(const unsigned char* base, size_t size, size_t& cursor) {
+    if (cursor + sizeof(T) > size) {
+        throw IoTDataFileException("Error: Snapshot directory is truncated.");
+    }
+    T value;
+    std::memcpy(&value, base + cursor, sizeof(T));
+    cursor += sizeof(T);
+    return value;
+}
+
+void appendDoubles(std::vector<unsigned char>& buffer, const std::vector<double>& values) {
+    appendValue<uint32_t>(buffer, static_cast<uint32_t>(values.size()));
+    for (double value : values) {
+        appendValue<double>(buffer, value);
+    }
+}
+
+std::vector<double> readDoubles(const unsigned char* base, size_t size, size_t& cursor) {
+    uint32_t count = readValue<uint32_t>(base, size, cursor);
+    if (count > (size - cursor) / sizeof(double)) {
+        throw IoTDataFileException("Error: Snapshot directory is truncated.");
+    }
+    std::vector<double> values(count);
+    if (count > 0) {
+        std::memcpy(values.data(), base + cursor, count * sizeof(double));
+    }
+    cursor += count * sizeof(double);
+    return values;
+}
+
+} // namespace
+
+void IoTDataSnapshot::write(const std::vector<std::pair<std::string, const IoTData*>>& series,
+                            const std::string& filename, size_t threadCount) {
+    // Lay out every column first so sections can be written independently
+    std::vector<WriteTask> tasks;
+    std::vector<unsigned char> directory;
+    uint64_t offset = kHeaderSize;
+
+    auto addColumn = [&tasks, &offset](const double* source, size_t count) {
+        uint64_t columnOffset = offset;
+        for (size_t begin = 0; begin < count; begin += kWriteChunkElements) {
+            size_t chunk = std::min(kWriteChunkElements, count - begin);
+            tasks.push_back({source + begin, chunk, offset});
+            offset += chunk * sizeof(double);
+        }
+        return columnOffset;
+    };
+
+    // Spline caches are copied under their lock, since const readers of the series may be filling them
+    std::vector<std::vector<double>> splines;
+    splines.reserve(series.size());
+    for (const auto& entry : series) {
+        const IoTData& data = *entry.second;
+        uint64_t count = data.data.size();
+        uint64_t valuesOffset = addColumn(data.data.data(), data.data.size());
+        uint64_t timestampsOffset = addColumn(data.timestamps.data(), data.timestamps.size());
+        splines.push_back(data.splineCache.copy());
+        uint64_t splineOffset = addColumn(splines.back().data(), splines.back().size());
+
+        appendValue<uint32_t>(directory, static_cast<uint32_t>(entry.first.size()));
+        directory.insert(directory.end(), entry.first.begin(), entry.first.end());
+        appendValue<uint64_t>(directory, count);
+        appendValue<uint64_t>(directory, valuesOffset);
+        appendValue<uint64_t>(directory, timestampsOffset);
+        appendValue<uint64_t>(directory, splines.back().size());
+        appendValue<uint64_t>(directory, splineOffset);
+        appendValue<uint32_t>(directory, static_cast<uint32_t>(data.duplicatePolicy));
+        appendValue<uint32_t>(directory, static_cast<uint32_t>(data.recentDuplicateCounts.size()));
+        for (const auto& duplicate : data.recentDuplicateCounts) {
+            appendValue<uint64_t>(directory, duplicate.first);
+            appendValue<uint64_t>(directory, duplicate.second);
+        }
+        if (data.calibration) {
+            appendValue<uint32_t>(directory, static_cast<uint32_t>(data.calibration->kind));
+            appendDoubles(directory, data.calibration->coefficients);
+            appendDoubles(directory, data.calibration->tableRaw);
+            appendDoubles(directory, data.calibration->tableCalibrated);
+        } else {
+            appendValue<uint32_t>(directory, kNoCalibration);
+        }
+    }
+
+    SnapshotHeader header;
+    std::memcpy(header.magic, kSnapshotMagic, sizeof(header.magic));
+    header.version = kSnapshotVersion;
+    header.seriesCount = static_cast<uint32_t>(series.size());
+    header.directoryOffset = offset;
+    header.directorySize = directory.size();
+
+    // Write to a uniquely named temporary file and rename so a crash never leaves a torn snapshot behind,
+    // and concurrent saves of the same file never share one
+    std::string temporary = filename + ".XXXXXX";
+    int fd = ::mkstemp(&temporary[0]);
+    if (fd < 0) {
+        throw IoTDataFileException("Error: Unable to open the file for snapshot export.");
+    }
+
+    try {
+        if (::fchmod(fd, 0644) != 0) {
+            throw IoTDataFileException("Error: Unable to open the file for snapshot export.");
+        }
+        if (::ftruncate(fd, static_cast<off_t>(offset + directory.size())) != 0) {
+            throw IoTDataFileException("Error: Unable to size the snapshot file.");
+        }
+
+        if (threadCount == 0) {
+            threadCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+        }
+        threadCount = std::min(threadCount, std::max<size_t>(1, tasks.size()));
+
+        std::atomic<size_t> nextTask(0);
+        std::exception_ptr failure;
+        std::mutex failureMutex;
+        auto worker = [&]() {
+            for (size_t i = nextTask++; i < tasks.size(); i = nextTask++) {
+                try {
+                    writeAll(fd, tasks[i].source, tasks[i].count * sizeof(double), tasks[i].offset);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(failureMutex);
+                    failure = std::current_exception();
+                    nextTask = tasks.size();
+                }
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (size_t t = 1; t < threadCount; ++t) {
+            workers.emplace_back(worker);
+        }
+        worker();
+        for (std::thread& thread : workers) {
+            thread.join();
+        }
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
+
+        writeAll(fd, directory.data(), directory.size(), offset);
+        writeAll(fd, &header, sizeof(header), 0);
+
+        if (::fsync(fd) != 0) {
+            throw IoTDataFileException("Error: Unable to flush the snapshot file.");
+        }
+    } catch (...) {
+        ::close(fd);
+        std::remove(temporary.c_str());
+        throw;
+    }
+
+    ::close(fd);
+    if (std::rename(temporary.c_str(), filename.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        throw IoTDataFileException("Error: Unable to replace the snapshot file.");
+    }
+
+    // The rename is only durable once the directory entry itself is flushed
+    size_t slash = filename.find_last_of('/');
+    std::string directoryPath = slash == std::string::npos ? "." : slash == 0 ? "/" : filename.substr(0, slash);
+    int directoryFd = ::open(directoryPath.c_str(), O_RDONLY | O_DIRECTORY);
+    if (directoryFd < 0 || ::fsync(directoryFd) != 0) {
+        if (directoryFd >= 0) {
+            ::close(directoryFd);
+        }
+        throw IoTDataFileException("Error: Unable to flush the snapshot directory.");
+    }
+    ::close(directoryFd);
+}
+
+void IoTDataSnapshot::save(const IoTData& series, const std::string& filename) {
+    write({{std::string(), &series}}, filename, 1);
+}
+
+void IoTDataSnapshot::save(const IoTDataStore& store, const std::string& filename, size_t threadCount) {
+    std::vector<std::pair<std::string, const IoTData*>> series;
+    series.reserve(store.getSeriesCount());
+    for (const auto& entry : store) {
+        series.emplace_back(entry.first, &entry.second);
+    }
+    write(series, filename, threadCount);
+}
+
+IoTData IoTDataSnapshot::load(const std::string& filename) {
+    IoTDataSnapshotReader reader(filename);
+    std::vector<std::string> ids = reader.getSeriesIds();
+    if (ids.size() != 1) {
+        throw IoTDataFileException("Error: Snapshot does not contain exactly one series.");
+    }
+    return reader.load(ids.front());
+}
+
+void IoTDataSnapshot::restore(IoTDataStore& store, const std::string& filename) {
+    IoTDataSnapshotReader reader(filename);
+    for (const std::string& id : reader.getSeriesIds()) {
+        store.addSeries(id, reader.load(id));
+    }
+}
+
+IoTDataSnapshotReader::IoTDataSnapshotReader(const std::string& filename) {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw IoTDataFileException("Error: Unable to open the file for snapshot import.");
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<uint64_t>(info.st_size) < kHeaderSize) {
+        ::close(fd);
+        throw IoTDataFileException("Error: Snapshot file is too small.");
+    }
+
+    mappingSize = static_cast<size_t>(info.st_size);
+    void* address = ::mmap(nullptr, mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        throw IoTDataFileException("Error: Unable to map the snapshot file.");
+    }
+    mapping = static_cast<const unsigned char*>(address);
+
+    try {
+        parseDirectory();
+    } catch (...) {
+        ::munmap(const_cast<unsigned char*>(mapping), mappingSize);
+        throw;
+    }
+}
+
+IoTDataSnapshotReader::~IoTDataSnapshotReader() {
+    ::munmap(const_cast<unsigned char*>(mapping), mappingSize);
+}
+
+void IoTDataSnapshotReader::parseDirectory() {
+    SnapshotHeader header;
+    std::memcpy(&header, mapping, sizeof(header));
+    if (std::memcmp(header.magic, kSnapshotMagic, sizeof(header.magic)) != 0) {
+        throw IoTDataFileException("Error: File is not an IoTData snapshot.");
+    }
+    if (header.version != 1 && header.version != kSnapshotVersion) {
+        throw IoTDataFileException("Error: Unsupported snapshot version.");
+    }
+    if (header.directoryOffset > mappingSize || header.directorySize > mappingSize - header.directoryOffset) {
+        throw IoTDataFileException("Error: Snapshot directory is out of bounds.");
+    }
+
+    const unsigned char* base = mapping + header.directoryOffset;
+    size_t size = static_cast<size_t>(header.directorySize);
+    size_t cursor = 0;
+
+    auto checkColumn = [this](uint64_t offset, uint64_t count) {
+        if (offset % sizeof(double) != 0 || offset > mappingSize || count > (mappingSize - offset) / sizeof(double)) {
+            throw IoTDataFileException("Error: Snapshot column is out of bounds.");
+        }
+    };
+
+    for (uint32_t s = 0; s < header.seriesCount; ++s) {
+        uint32_t idLength = readValue<uint32_t>(base, size, cursor);
+        if (cursor + idLength > size) {
+            throw IoTDataFileException("Error: Snapshot directory is truncated.");
+        }
+        std::string id(reinterpret_cast<const char*>(base + cursor), idLength);
+        cursor += idLength;
+
+        SeriesEntry entry;
+        entry.count = readValue<uint64_t>(base, size, cursor);
+        entry.valuesOffset = readValue<uint64_t>(base, size, cursor);
+        entry.timestampsOffset = readValue<uint64_t>(base, size, cursor);
+        entry.splineCount = readValue<uint64_t>(base, size, cursor);
+        entry.splineOffset = readValue<uint64_t>(base, size, cursor);
+        entry.duplicatePolicy = readValue<uint32_t>(base, size, cursor);
+        uint32_t duplicateCount = readValue<uint32_t>(base, size, cursor);
+        for (uint32_t d = 0; d < duplicateCount; ++d) {
+            uint64_t index = readValue<uint64_t>(base, size, cursor);
+            uint64_t merged = readValue<uint64_t>(base, size, cursor);
+            entry.recentDuplicateCounts.emplace_back(static_cast<size_t>(index), static_cast<size_t>(merged));
+        }
+        if (header.version >= 2) {
+            entry.calibration = readCalibration(base, size, cursor);
+        }
+
+        checkColumn(entry.valuesOffset, entry.count);
+        checkColumn(entry.timestampsOffset, entry.count);
+        checkColumn(entry.splineOffset, entry.splineCount);
+        if (entry.duplicatePolicy > static_cast<uint32_t>(DuplicatePolicy::MAX)) {
+            throw IoTDataFileException("Error: Snapshot contains an unknown duplicate policy.");
+        }
+
+        directory.emplace(std::move(id), std::move(entry));
+    }
+}
+
+std::shared_ptr<const IoTDataCalibration> IoTDataSnapshotReader::readCalibration(const unsigned char* base,
+                                                                                  size_t size, size_t& cursor) {
+    uint32_t kind = readValue<uint32_t>(base, size, cursor);
+    if (kind == kNoCalibration) {
+        return nullptr;
+    }
+    std::vector<double> coefficients = readDoubles(base, size, cursor);
+    std::vector<double> tableRaw = readDoubles(base, size, cursor);
+    std::vector<double> tableCalibrated = readDoubles(base, size, cursor);
+
+    // Rebuilt through the factories, which validate the parameters and derive the lookup acceleration
+    try {
+        switch (static_cast<CalibrationKind>(kind)) {
+            case CalibrationKind::IDENTITY:
+                return std::make_shared<const IoTDataCalibration>();
+            case CalibrationKind::AFFINE:
+                if (coefficients.size() == 2) {
+                    return std::make_shared<const IoTDataCalibration>(
+                        IoTDataCalibration::affine(coefficients[1], coefficients[0]));
+                }
+                break;
+            case CalibrationKind::POLYNOMIAL:
+                return std::make_shared<const IoTDataCalibration>(IoTDataCalibration::polynomial(coefficients));
+            case CalibrationKind::LOOKUP_TABLE:
+                return std::make_shared<const IoTDataCalibration>(
+                    IoTDataCalibration::lookupTable(tableRaw, tableCalibrated));
+        }
+    } catch (const IoTDataException&) {
+    }
+    throw IoTDataFileException("Error: Snapshot contains an invalid calibration.");
+}
+
+const IoTDataSnapshotReader::SeriesEntry& IoTDataSnapshotReader::findEntry(const std::string& seriesId) const {
+    auto it = directory.find(seriesId);
+    if (it == directory.end()) {
+        throw IoTDataException("Error: Unknown series '" + seriesId + "' in snapshot.");
+    }
+    return it->second;
+}
+
+std::vector<std::string> IoTDataSnapshotReader::getSeriesIds() const {
+    std::vector<std::string> ids;
+    ids.reserve(directory.size());
+    for (const auto& entry : directory) {
+        ids.push_back(entry.first);
+    }
+    return ids;
+}
+
+size_t IoTDataSnapshotReader::getSeriesSize(const std::string& seriesId) const {
+    return static_cast<size_t>(findEntry(seriesId).count);
+}
+
+IoTDataView IoTDataSnapshotReader::view(const std::string& seriesId) const {
+    const SeriesEntry& entry = findEntry(seriesId);
+    return IoTDataView(reinterpret_cast<const double*>(mapping + entry.valuesOffset),
+                       reinterpret_cast<const double*>(mapping + entry.timestampsOffset),
+                       static_cast<size_t>(entry.count));
+}
+
+IoTData IoTDataSnapshotReader::load(const std::string& seriesId) const {
+    const SeriesEntry& entry = findEntry(seriesId);
+    IoTDataView columns = view(seriesId);
+
+    IoTData series(std::vector<double>(columns.values(), columns.values() + columns.size()),
+                   std::vector<double>(columns.timestamps(), columns.timestamps() + columns.size()));
+
+    const double* spline = reinterpret_cast<const double*>(mapping + entry.splineOffset);
+    series.splineCache.coefficients.assign(spline, spline + entry.splineCount);
+    series.splineCache.valid = entry.splineCount > 0;
+    series.duplicatePolicy = static_cast<DuplicatePolicy>(entry.duplicatePolicy);
+    series.recentDuplicateCounts = entry.recentDuplicateCounts;
+    series.calibration = entry.calibration;
+    return series;
+}
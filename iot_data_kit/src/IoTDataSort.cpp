@@ -0,0 +1,208 @@
+// IoTDataSort.cpp
+#include "IoTDataSort.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+
+namespace IoTDataSort {
+
+namespace {
+
+constexpr size_t kRadixBits = 8;
+constexpr size_t kBuckets = size_t(1) << kRadixBits;
+constexpr size_t kPasses = 64 / kRadixBits;
+constexpr size_t kParallelThreshold = size_t(1) << 16;
+constexpr size_t kSelectBits = 16;
+constexpr size_t kSelectBuckets = size_t(1) << kSelectBits;
+constexpr size_t kSelectShift = 64 - kSelectBits;
+
+struct Entry {
+    uint64_t key;
+    double payload;
+};
+
+using Histogram = std::array<size_t, kBuckets>;
+
+// Order-preserving mapping from IEEE-754 doubles to unsigned integers
+uint64_t encodeKey(double value) {
+    if (std::isnan(value)) {
+        return ~uint64_t(0);
+    }
+
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x8000000000000000ULL) ? ~bits : (bits | 0x8000000000000000ULL);
+}
+
+double decodeKey(uint64_t key) {
+    uint64_t bits = (key & 0x8000000000000000ULL) ? (key & ~0x8000000000000000ULL) : ~key;
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+} // namespace
+
+size_t resolveThreadCount(size_t threadCount, size_t count) {
+    if (count < kParallelThreshold) {
+        return 1;
+    }
+    return threadCount == 0 ? std::max<size_t>(1, std::thread::hardware_concurrency()) : threadCount;
+}
+
+bool radixSortByKey(std::vector<double>& keys, std::vector<double>& payload, size_t threadCount) {
+    // Cheap single pass for the common case of already ordered input. It compares the radix keys, since
+    // operator< would accept misplaced NaNs (e.g. [1, NaN, 0]) as sorted.
+    if (std::is_sorted(keys.begin(), keys.end(), [](double a, double b) { return encodeKey(a) < encodeKey(b); })) {
+        return false;
+    }
+
+    size_t count = keys.size();
+    threadCount = resolveThreadCount(threadCount, count);
+
+    std::vector<Entry> source(count);
+    std::vector<Entry> target(count);
+    std::vector<std::array<Histogram, kPasses>> histograms(threadCount);
+
+    // Encode and build the histograms of every digit in one pass per chunk
+    parallelChunks(threadCount, count, [&](size_t t, size_t begin, size_t end) {
+        std::array<Histogram, kPasses>& local = histograms[t];
+        for (Histogram& histogram : local) {
+            histogram.fill(0);
+        }
+        for (size_t i = begin; i < end; ++i) {
+            uint64_t key = encodeKey(keys[i]);
+            source[i] = {key, payload[i]};
+            for (size_t pass = 0; pass < kPasses; ++pass) {
+                ++local[pass][(key >> (pass * kRadixBits)) & (kBuckets - 1)];
+            }
+        }
+    });
+
+    for (size_t pass = 0; pass < kPasses; ++pass) {
+        size_t shift = pass * kRadixBits;
+
+        // Digits shared by every key (e.g. the high bytes of epoch timestamps) need no pass
+        Histogram total{};
+        for (size_t t = 0; t < threadCount; ++t) {
+            for (size_t b = 0; b < kBuckets; ++b) {
+                total[b] += histograms[t][pass][b];
+            }
+        }
+        if (std::any_of(total.begin(), total.end(), [count](size_t n) { return n == count; })) {
+            continue;
+        }
+
+        // Chunk-local per-pass histograms are only valid for the current layout, so recount
+        std::vector<Histogram> chunkCounts(threadCount);
+        parallelChunks(threadCount, count, [&](size_t t, size_t begin, size_t end) {
+            Histogram& local = chunkCounts[t];
+            local.fill(0);
+            for (size_t i = begin; i < end; ++i) {
+                ++local[(source[i].key >> shift) & (kBuckets - 1)];
+            }
+        });
+
+        // Bucket-major, chunk-minor offsets keep the scatter stable
+        std::vector<Histogram> offsets(threadCount);
+        size_t running = 0;
+        for (size_t b = 0; b < kBuckets; ++b) {
+            for (size_t t = 0; t < threadCount; ++t) {
+                offsets[t][b] = running;
+                running += chunkCounts[t][b];
+            }
+        }
+
+        parallelChunks(threadCount, count, [&](size_t t, size_t begin, size_t end) {
+            Histogram& offset = offsets[t];
+            for (size_t i = begin; i < end; ++i) {
+                target[offset[(source[i].key >> shift) & (kBuckets - 1)]++] = source[i];
+            }
+        });
+
+        source.swap(target);
+    }
+
+    parallelChunks(threadCount, count, [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            keys[i] = decodeKey(source[i].key);
+            payload[i] = source[i].payload;
+        }
+    });
+
+    return true;
+}
+
+std::vector<double> selectRanks(const double* values, size_t count, const std::vector<size_t>& ranks,
+                                size_t threadCount) {
+    threadCount = resolveThreadCount(threadCount, count);
+
+    // Pass 1: histogram of the top key bits locates the bucket holding each rank
+    std::vector<std::vector<size_t>> histograms(threadCount, std::vector<size_t>(kSelectBuckets, 0));
+    parallelChunks(threadCount, count, [&](size_t t, size_t begin, size_t end) {
+        std::vector<size_t>& local = histograms[t];
+        for (size_t i = begin; i < end; ++i) {
+            ++local[encodeKey(values[i]) >> kSelectShift];
+        }
+    });
+
+    std::vector<size_t> total(kSelectBuckets, 0);
+    for (const std::vector<size_t>& local : histograms) {
+        for (size_t b = 0; b < kSelectBuckets; ++b) {
+            total[b] += local[b];
+        }
+    }
+
+    std::vector<size_t> buckets;          // Distinct buckets holding a requested rank
+    std::vector<size_t> rankBucket(ranks.size());
+    std::vector<size_t> localRank(ranks.size());
+    for (size_t r = 0; r < ranks.size(); ++r) {
+        size_t below = 0;
+        size_t b = 0;
+        while (below + total[b] <= ranks[r]) {
+            below += total[b++];
+        }
+        auto it = std::find(buckets.begin(), buckets.end(), b);
+        rankBucket[r] = it - buckets.begin();
+        if (it == buckets.end()) {
+            buckets.push_back(b);
+        }
+        localRank[r] = ranks[r] - below;
+    }
+
+    // Pass 2: gather only the candidates of those buckets, then select within them
+    std::vector<std::vector<std::vector<double>>> gathered(threadCount,
+                                                           std::vector<std::vector<double>>(buckets.size()));
+    parallelChunks(threadCount, count, [&](size_t t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            size_t bucket = encodeKey(values[i]) >> kSelectShift;
+            for (size_t c = 0; c < buckets.size(); ++c) {
+                if (buckets[c] == bucket) {
+                    gathered[t][c].push_back(values[i]);
+                    break;
+                }
+            }
+        }
+    });
+
+    std::vector<std::vector<double>> candidates(buckets.size());
+    for (size_t c = 0; c < buckets.size(); ++c) {
+        for (size_t t = 0; t < threadCount; ++t) {
+            candidates[c].insert(candidates[c].end(), gathered[t][c].begin(), gathered[t][c].end());
+        }
+    }
+
+    std::vector<double> results(ranks.size());
+    for (size_t r = 0; r < ranks.size(); ++r) {
+        std::vector<double>& bucket = candidates[rankBucket[r]];
+        std::nth_element(bucket.begin(), bucket.begin() + localRank[r], bucket.end(),
+                         [](double a, double b) { return encodeKey(a) < encodeKey(b); });
+        results[r] = bucket[localRank[r]];
+    }
+    return results;
+}
+
+} // namespace IoTDataSort
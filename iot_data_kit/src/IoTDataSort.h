@@ -0,0 +1,49 @@
+// IoTDataSort.h
+// Internal parallel LSD radix sort used to order series by timestamp, and radix-based selection.
+#ifndef IOT_DATA_SORT_H
+#define IOT_DATA_SORT_H
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace IoTDataSort {
+
+// Stable co-sort of keys and payload by ascending key (NaN keys sort last).
+// Returns false without touching either vector when keys are already sorted.
+bool radixSortByKey(std::vector<double>& keys, std::vector<double>& payload, size_t threadCount = 0);
+
+// Values at the given ascending-order ranks (each < count), leaving the input untouched:
+// a histogram pass over the top key bits, then selection among the few candidates sharing a rank's bucket.
+// NaN ranks last. O(count) time.
+std::vector<double> selectRanks(const double* values, size_t count, const std::vector<size_t>& ranks,
+                                size_t threadCount = 0);
+
+// Thread count used by the parallel kernels (0 = hardware concurrency, 1 for small inputs)
+size_t resolveThreadCount(size_t threadCount, size_t count);
+
+// Calls f(chunkIndex, begin, end) for threadCount contiguous chunks of [0, count), one thread each
+template <typename F>
+void parallelChunks(size_t threadCount, size_t count, F f) {
+    if (threadCount == 1) {
+        f(0, 0, count);
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount);
+    size_t chunk = (count + threadCount - 1) / threadCount;
+    for (size_t t = 0; t < threadCount; ++t) {
+        size_t begin = std::min(count, t * chunk);
+        size_t end = std::min(count, begin + chunk);
+        workers.emplace_back(f, t, begin, end);
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+} // namespace IoTDataSort
+
+#endif // IOT_DATA_SORT_H
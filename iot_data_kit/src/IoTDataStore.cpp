@@ -0,0 +1,114 @@
+// IoTDataStore.cpp
+#include "IoTDataStore.h"
+#include "IoTDataException.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+IoTData& IoTDataStore::addSeries(const std::string& seriesId) {
+    auto it = series.find(seriesId);
+    if (it != series.end()) {
+        return it->second;
+    }
+    return series.emplace(seriesId, IoTData(std::vector<double>())).first->second;
+}
+
+IoTData& IoTDataStore::addSeries(const std::string& seriesId, IoTData seriesData) {
+    auto result = series.insert_or_assign(seriesId, std::move(seriesData));
+    return result.first->second;
+}
+
+void IoTDataStore::removeSeries(const std::string& seriesId) {
+    series.erase(seriesId);
+}
+
+bool IoTDataStore::hasSeries(const std::string& seriesId) const {
+    return series.find(seriesId) != series.end();
+}
+
+void IoTDataStore::clear() {
+    series.clear();
+}
+
+IoTData& IoTDataStore::getSeries(const std::string& seriesId) {
+    auto it = series.find(seriesId);
+    if (it == series.end()) {
+        throw IoTDataException("Error: Unknown series '" + seriesId + "'.");
+    }
+    return it->second;
+}
+
+const IoTData& IoTDataStore::getSeries(const std::string& seriesId) const {
+    auto it = series.find(seriesId);
+    if (it == series.end()) {
+        throw IoTDataException("Error: Unknown series '" + seriesId + "'.");
+    }
+    return it->second;
+}
+
+std::vector<std::string> IoTDataStore::getSeriesIds() const {
+    std::vector<std::string> ids;
+    ids.reserve(series.size());
+    for (const auto& entry : series) {
+        ids.push_back(entry.first);
+    }
+    return ids;
+}
+
+size_t IoTDataStore::getSeriesCount() const {
+    return series.size();
+}
+
+void IoTDataStore::appendData(const std::string& seriesId, double newData, double timestamp) {
+    addSeries(seriesId).appendData(newData, timestamp);
+}
+
+void IoTDataStore::setCalibration(const std::string& seriesId, const IoTDataCalibration& calibration) {
+    addSeries(seriesId).setCalibration(calibration);
+}
+
+void IoTDataStore::normalizeAll(NormalizationMethod method, size_t threadCount) {
+    std::vector<IoTData*> pending;
+    for (auto& entry : series) {
+        if (entry.second.getDataSize() > 0) {
+            pending.push_back(&entry.second);
+        }
+    }
+
+    if (threadCount == 0) {
+        threadCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+    threadCount = std::min(threadCount, pending.size());
+
+    // Series are handed out one at a time so a few long series do not stall a fixed partition
+    std::atomic<size_t> next(0);
+    std::exception_ptr firstError;
+    std::mutex errorMutex;
+    auto worker = [&]() {
+        for (size_t i = next++; i < pending.size(); i = next++) {
+            try {
+                pending[i]->normalizeData(method);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!firstError) {
+                    firstError = std::current_exception();
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t t = 1; t < threadCount; ++t) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+
+    if (firstError) {
+        std::rethrow_exception(firstError);
+    }
+}
@@ -0,0 +1,59 @@
+// IoTDataSharedRingTest.cpp
+#include "IoTDataSharedRing.h"
+#include "IoTData.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "FAILED: " << message << std::endl;
+        ++failures;
+    }
+}
+
+} // namespace
+
+int main() {
+    const std::string name = "/iot_data_kit_ring_test_" + std::to_string(::getpid());
+
+    {
+        IoTDataSharedRing writer = IoTDataSharedRing::create(name, 8);
+        IoTDataSharedRing reader = IoTDataSharedRing::open(name);
+
+        for (int i = 0; i < 5; ++i) {
+            writer.appendData(i * 1.5, i);
+        }
+        IoTData received(std::vector<double>{});
+        check(reader.readInto(received) == 5, "reader receives every published point");
+        check(received.getDataSize() == 5 && received.view().values()[4] == 6.0, "points arrive in order");
+
+        // Lapping the reader drops the overwritten points and counts them as lost
+        for (int i = 5; i < 25; ++i) {
+            writer.appendData(i * 1.5, i);
+        }
+        check(reader.readInto(received) == 8, "reader keeps only the retained points after a lap");
+        check(reader.getLostCount() == 12, "overwritten points are counted as lost");
+        check(received.view().timestamps()[received.getDataSize() - 1] == 24.0, "newest point is read last");
+
+        // Recreating the ring must not invalidate the old reader's mapping
+        IoTDataSharedRing replacement = IoTDataSharedRing::create(name, 4);
+        replacement.appendData(1.0, 100.0);
+        check(reader.readInto(received) == 0, "old reader sees no points of the replacement");
+        check(reader.getWriteSequence() == 25, "old reader still maps the previous ring");
+
+        IoTDataSharedRing newReader = IoTDataSharedRing::open(name, true);
+        check(newReader.getCapacity() == 4 && newReader.readInto(received) == 1, "new reader opens the replacement");
+        replacement.unlink();
+    }
+
+    if (failures == 0) {
+        std::cout << "IoTDataSharedRing tests passed" << std::endl;
+    }
+    return failures == 0 ? 0 : 1;
+}